@@ -573,11 +573,19 @@ inline int StringLength(char const* s)
 #ifdef _WIN32
     #include <io.h>
     #include <direct.h>
+    #ifndef WIN32_LEAN_AND_MEAN
+    #   define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+    #   define NOMINMAX
+    #endif
+    #include <windows.h> // file mapping
     #define F_OK 0
     #define access _access
 #else 
     #include <unistd.h>
     #include <sys/types.h>
+    #include <sys/mman.h>
     #include <fcntl.h>
     #define _mkdir mkdir
     #define _fileno fileno
@@ -755,19 +763,28 @@ inline uint64_t AFileSize(AFile file) {
     long fileSize = ftell(file.file);
     if (fileSize == -1) 
         return 0; // Or handle the error as appropriate
+    fseek(file.file, 0, SEEK_SET); // rewind, otherwise following reads returns nothing
     return (uint64_t)fileSize;
 #endif  
 }
 
 #endif
 
-inline char* ReadAllFile(const char* fileName, char* buffer = 0) {
+// zeroed bytes after the text that parser reads, so 8 byte key compares and 64 byte simd blocks
+// can read past the end without tail checks. also used as null terminator
+enum { AReadPadding = 64 };
+
+// if buffer is given it must be at least file size + AReadPadding bytes
+inline char* ReadAllFile(const char* fileName, char* buffer = 0, uint64_t* outSize = 0) {
     AFile file = AFileOpen(fileName, AOpenFlag_Read);
+    if (!AFileExist(file)) return nullptr;
     uint64_t fileSize = AFileSize(file);
     if (buffer == nullptr) 
-        buffer = (char*)AX_CALLOC(fileSize); // +1 for null terminator
+        buffer = (char*)AX_MALLOC(fileSize + AReadPadding);
     AFileRead(buffer, fileSize, file);
     AFileClose(file);
+    MemsetZero(buffer + fileSize, AReadPadding);
+    if (outSize) *outSize = fileSize;
     return buffer;
 }
 
@@ -775,6 +792,232 @@ inline void FreeAllText(char* text) {
     AX_FREE(text);
 }
 
+// returns false if file is not exist, modified time is in seconds
+inline bool AFileInfo(const char* fileName, uint64_t* outSize, uint64_t* outModifiedTime) {
+#if defined(__ANDROID__)
+    // apk assets doesn't have modified time, they only change with the apk
+    AFile file = AFileOpen(fileName, AOpenFlag_Read);
+    if (!AFileExist(file)) return false;
+    *outSize = AFileSize(file);
+    *outModifiedTime = 0;
+    AFileClose(file);
+    return true;
+#elif defined(_WIN32)
+    struct _stat64 st;
+    if (_stat64(fileName, &st) != 0) return false;
+    *outSize = (uint64_t)st.st_size;
+    *outModifiedTime = (uint64_t)st.st_mtime;
+    return true;
+#else
+    struct stat st;
+    if (stat(fileName, &st) != 0) return false;
+    *outSize = (uint64_t)st.st_size;
+    *outModifiedTime = (uint64_t)st.st_mtime;
+    return true;
+#endif
+}
+
+// maps whole file into memory as read only, pages are loaded lazily when we touch them.
+// copyOnWrite makes mapping writable, written pages are private copies and file doesn't change.
+// returns null and sets outSize to zero if file is not exist or mapping fails. free with AUnmapFile
+inline void* AMapFile(const char* fileName, uint64_t* outSize, bool copyOnWrite = false) {
+#if defined(__ANDROID__)
+    // assets are compressed in apk, we can't map them
+    *outSize = 0;
+    return ReadAllFile(fileName, nullptr, outSize);
+#elif defined(_WIN32)
+    *outSize = 0;
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0) : nullptr;
+    // view keeps the file open, we don't need the handles anymore
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    if (data) *outSize = (uint64_t)size.QuadPart;
+    return data;
+#else
+    *outSize = 0;
+    int fd = open(fileName, O_RDONLY);
+    if (fd == -1) return nullptr;
+    struct stat sb;
+    void* data = nullptr;
+    if (fstat(fd, &sb) == 0 && sb.st_size > 0) {
+        int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        data = mmap(nullptr, (size_t)sb.st_size, prot, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) data = nullptr;
+    }
+    close(fd); // mapping keeps the file open
+    if (data) *outSize = (uint64_t)sb.st_size;
+    return data;
+#endif
+}
+
+inline void AUnmapFile(void* data, uint64_t size) {
+#if defined(__ANDROID__)
+    FreeAllText((char*)data);
+#elif defined(_WIN32)
+    UnmapViewOfFile(data);
+#else
+    munmap(data, (size_t)size);
+#endif
+}
+
+/*****************************************************************
+*                             Thread                             *
+*****************************************************************/
+
+#ifdef _WIN32
+    typedef HANDLE AThread;
+#else
+    #include <pthread.h>
+    typedef pthread_t AThread;
+#endif
+
+typedef void(*AThreadFunc)(void* arg);
+
+struct AThreadStart { AThreadFunc func; void* arg; };
+
+#ifdef _WIN32
+static DWORD WINAPI AThreadEntry(LPVOID param)
+#else
+static void* AThreadEntry(void* param)
+#endif
+{
+    AThreadStart start = *(AThreadStart*)param;
+    AX_FREE(param);
+    start.func(start.arg);
+    return 0;
+}
+
+// returns false if thread couldn't be created, in that case caller should do the work itself
+inline bool AThreadCreate(AThread* thread, AThreadFunc func, void* arg) {
+    AThreadStart* start = (AThreadStart*)AX_MALLOC(sizeof(AThreadStart));
+    start->func = func;
+    start->arg  = arg;
+#ifdef _WIN32
+    *thread = CreateThread(nullptr, 0, AThreadEntry, start, 0, nullptr);
+    bool created = *thread != nullptr;
+#else
+    bool created = pthread_create(thread, nullptr, AThreadEntry, start) == 0;
+#endif
+    if (!created) AX_FREE(start);
+    return created;
+}
+
+inline void AThreadJoin(AThread thread) {
+#ifdef _WIN32
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, nullptr);
+#endif
+}
+
+// returns old value
+inline int AAtomicAdd(volatile int* value, int add) {
+#ifdef _WIN32
+    return (int)InterlockedExchangeAdd((volatile LONG*)value, add);
+#else
+    return __atomic_fetch_add(value, add, __ATOMIC_RELAXED);
+#endif
+}
+
+inline int ANumHardwareThreads() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+#endif
+}
+
+typedef void(*AParallelFunc)(int index, void* arg);
+
+// each worker has it's own range of indices, when it's finished it steals from the other workers ranges.
+// padded to cache line size, so workers doesn't invalidate each other's cursors
+struct AParallelRange { volatile int next; int end; char pad[56]; };
+
+struct AParallelWork
+{
+    AParallelFunc   func;
+    void*           arg;
+    AParallelRange* ranges;
+    int             numWorkers;
+    volatile int    nextWorker;
+};
+
+// true while this thread runs a parallel task, AParallelFor called from a task runs serially.
+// otherwise nested loops (ParseGLTFBatch with parallel flags) would create numThreads * numThreads threads
+static thread_local bool AInParallelTask = false;
+
+static void AParallelWorker(void* param)
+{
+    AParallelWork* work = (AParallelWork*)param;
+    int self = AAtomicAdd(&work->nextWorker, 1);
+    bool wasInTask = AInParallelTask;
+    AInParallelTask = true;
+    
+    // start with own range, then steal from the next ones
+    for (int i = 0; i < work->numWorkers; i++)
+    {
+        AParallelRange& range = work->ranges[(self + i) % work->numWorkers];
+        int index;
+        while ((index = AAtomicAdd(&range.next, 1)) < range.end)
+            work->func(index, work->arg);
+    }
+    AInParallelTask = wasInTask;
+}
+
+// calls func(index, arg) for each index in [0, count) on multiple threads, calling thread works too.
+// numThreads 0 means number of cpu cores. returns after all of the work is done, nested calls run on the calling thread
+inline void AParallelFor(int count, AParallelFunc func, void* arg, int numThreads = 0)
+{
+    if (numThreads <= 0) numThreads = ANumHardwareThreads();
+    numThreads = AInParallelTask ? 1 : MIN(numThreads, count);
+    if (numThreads <= 1)
+    {
+        for (int i = 0; i < count; i++) func(i, arg);
+        return;
+    }
+
+    AParallelWork work;
+    work.func       = func;
+    work.arg        = arg;
+    work.numWorkers = numThreads;
+    work.nextWorker = 0;
+    work.ranges     = (AParallelRange*)AX_MALLOC(sizeof(AParallelRange) * numThreads);
+    
+    int perWorker = count / numThreads, remainder = count % numThreads, begin = 0;
+    for (int i = 0; i < numThreads; i++)
+    {
+        work.ranges[i].next = begin;
+        begin += perWorker + (i < remainder);
+        work.ranges[i].end  = begin;
+    }
+
+    // if we can't create a thread other workers steal it's range
+    AThread* threads = (AThread*)AX_MALLOC(sizeof(AThread) * (numThreads - 1));
+    int numCreated = 0;
+    for (int i = 0; i < numThreads - 1; i++)
+        numCreated += AThreadCreate(&threads[numCreated], AParallelWorker, &work);
+    
+    AParallelWorker(&work);
+
+    for (int i = 0; i < numCreated; i++)
+        AThreadJoin(threads[i]);
+
+    AX_FREE(threads);
+    AX_FREE(work.ranges);
+}
+
 inline constexpr bool IsNumber(char a) { return a <= '9' && a >= '0'; };
 inline constexpr bool IsLower(char a)  { return a >= 'a' && a <= 'z'; };
 inline constexpr bool IsUpper(char a)  { return a >= 'A' && a <= 'Z'; };
@@ -832,65 +1075,307 @@ inline bool IsParsable(const char* curr)
 	return true;
 }
 
-inline float ParseFloat(const char*& text)
+/*****************************************************************
+*                          Float Parsing                         *
+*****************************************************************/
+
+// Eisel-Lemire: https://arxiv.org/abs/2101.11408 (Daniel Lemire, Number Parsing at a Gigabyte per Second)
+// only float range is needed so table only has 5^-65 to 5^38, smaller numbers are zero bigger ones are infinity 
+// 128 bit normalized powers of five, high and low bits
+static const uint64_t APowerOfFive128[] = 
 {
-    const int MAX_POWER = 20;
-    const double POWER_10_POS[MAX_POWER] =
-    {
-        1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,  1.0e8,  1.0e9,
-        1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19,
-    };
+    0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL, 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL, // 5^-65
+    0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL, 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL, // 5^-63
+    0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL, 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL, // 5^-61
+    0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL, 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL, // 5^-59
+    0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL, 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL, // 5^-57
+    0x9CED737BB6C4183DULL, 0x55464DD69685606BULL, 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL, // 5^-55
+    0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL, 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL, // 5^-53
+    0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL, 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL, // 5^-51
+    0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL, 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL, // 5^-49
+    0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL, 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL, // 5^-47
+    0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL, 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL, // 5^-45
+    0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL, 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL, // 5^-43
+    0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL, 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL, // 5^-41
+    0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL, 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL, // 5^-39
+    0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL, 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL, // 5^-37
+    0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL, 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL, // 5^-35
+    0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL, 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL, // 5^-33
+    0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL, 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL, // 5^-31
+    0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL, 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL, // 5^-29
+    0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL, 0xC612062576589DDAULL, 0x95364AFE032A819EULL, // 5^-27
+    0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL, 0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL, // 5^-25
+    0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL, 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL, // 5^-23
+    0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL, 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL, // 5^-21
+    0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL, 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL, // 5^-19
+    0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL, 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL, // 5^-17
+    0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL, 0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL, // 5^-15
+    0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL, 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL, // 5^-13
+    0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL, 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL, // 5^-11
+    0x89705F4136B4A597ULL, 0x31680A88F8953031ULL, 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL, // 5^-9
+    0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL, 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL, // 5^-7
+    0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL, 0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL, // 5^-5
+    0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL, 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL, // 5^-3
+    0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL, 0x8000000000000000ULL, 0x0000000000000000ULL, // 5^-1
+    0xA000000000000000ULL, 0x0000000000000000ULL, 0xC800000000000000ULL, 0x0000000000000000ULL, // 5^1
+    0xFA00000000000000ULL, 0x0000000000000000ULL, 0x9C40000000000000ULL, 0x0000000000000000ULL, // 5^3
+    0xC350000000000000ULL, 0x0000000000000000ULL, 0xF424000000000000ULL, 0x0000000000000000ULL, // 5^5
+    0x9896800000000000ULL, 0x0000000000000000ULL, 0xBEBC200000000000ULL, 0x0000000000000000ULL, // 5^7
+    0xEE6B280000000000ULL, 0x0000000000000000ULL, 0x9502F90000000000ULL, 0x0000000000000000ULL, // 5^9
+    0xBA43B74000000000ULL, 0x0000000000000000ULL, 0xE8D4A51000000000ULL, 0x0000000000000000ULL, // 5^11
+    0x9184E72A00000000ULL, 0x0000000000000000ULL, 0xB5E620F480000000ULL, 0x0000000000000000ULL, // 5^13
+    0xE35FA931A0000000ULL, 0x0000000000000000ULL, 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL, // 5^15
+    0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL, 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL, // 5^17
+    0x8AC7230489E80000ULL, 0x0000000000000000ULL, 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL, // 5^19
+    0xD8D726B7177A8000ULL, 0x0000000000000000ULL, 0x878678326EAC9000ULL, 0x0000000000000000ULL, // 5^21
+    0xA968163F0A57B400ULL, 0x0000000000000000ULL, 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL, // 5^23
+    0x84595161401484A0ULL, 0x0000000000000000ULL, 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL, // 5^25
+    0xCECB8F27F4200F3AULL, 0x0000000000000000ULL, 0x813F3978F8940984ULL, 0x4000000000000000ULL, // 5^27
+    0xA18F07D736B90BE5ULL, 0x5000000000000000ULL, 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL, // 5^29
+    0xFC6F7C4045812296ULL, 0x4D00000000000000ULL, 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL, // 5^31
+    0xC5371912364CE305ULL, 0x6C28000000000000ULL, 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL, // 5^33
+    0x9A130B963A6C115CULL, 0x3C7F400000000000ULL, 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL, // 5^35
+    0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL, 0x96769950B50D88F4ULL, 0x1314448000000000ULL, // 5^37
+};
+
+struct AFloatBits { uint64_t mantissa; int power2; };
+
+__forceinline uint64_t AMul128(uint64_t a, uint64_t b, uint64_t* high)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)a * b;
+    *high = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, high);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    *high = __umulh(a, b);
+    return a * b;
+#else
+    uint64_t aLo = a & 0xFFFFFFFFull, aHi = a >> 32;
+    uint64_t bLo = b & 0xFFFFFFFFull, bHi = b >> 32;
+    uint64_t lolo = aLo * bLo, hilo = aHi * bLo, lohi = aLo * bHi;
+    uint64_t cross = (lolo >> 32) + (hilo & 0xFFFFFFFFull) + lohi;
+    *high = aHi * bHi + (hilo >> 32) + (cross >> 32);
+    return (cross << 32) | (lolo & 0xFFFFFFFFull);
+#endif
+}
+
+// w * 10^q to float bits, w != 0. correct if w has all of the digits, 
+// if digits are truncated result is correct only if w and w+1 gives same result
+inline AFloatBits EiselLemire(int q, uint64_t w)
+{
+    AFloatBits answer = { 0, 0 };
+    if (w == 0 || q < -65) return answer;
+    if (q > 38) { answer.power2 = 0xFF; return answer; }
+
+    int lz = (int)LeadingZeroCount64(w);
+    w <<= lz;
+    
+    const uint64_t* power = APowerOfFive128 + ((q + 65) << 1);
+    uint64_t high, low = AMul128(w, power[0], &high);
+    const uint64_t precisionMask = ~0ull >> 26; // 23 mantissa bits + 3
+    
+    if ((high & precisionMask) == precisionMask) 
+    {   // lower part of the power might change the result
+        uint64_t secondHigh; 
+        AMul128(w, power[1], &secondHigh);
+        low += secondHigh;
+        high += secondHigh > low;
+    }
+
+    int upperBit = (int)(high >> 63);
+    int shift = upperBit + 64 - 23 - 3;
+    answer.mantissa = high >> shift;
+    // 217706 / 65536 is log2(10), 63 is because w is normalized, 127 is exponent bias
+    answer.power2 = (((217706 * q) >> 16) + 63) + upperBit - lz + 127;
 
-    const double POWER_10_NEG[MAX_POWER] =
+    if (answer.power2 <= 0) // subnormal
     {
-        1.0e0,   1.0e-1,  1.0e-2,  1.0e-3,  1.0e-4,  1.0e-5,  1.0e-6,  1.0e-7,  1.0e-8,  1.0e-9,
-        1.0e-10, 1.0e-11, 1.0e-12, 1.0e-13, 1.0e-14, 1.0e-15, 1.0e-16, 1.0e-17, 1.0e-18, 1.0e-19,
-    };
+        if (-answer.power2 + 1 >= 64) { answer.mantissa = 0; answer.power2 = 0; return answer; }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = answer.mantissa < (1ull << 23) ? 0 : 1;
+        return answer;
+    }
 
-    const char* ptr = text;
-    while (!IsNumber(*ptr) && *ptr != '-') ptr++;
-	
-    double sign = 1.0;
-    if(*ptr == '-')
-        sign = -1.0, ptr++; 
+    // exactly halfway, round to even. only possible when 5^q fits in 64 bits 
+    if (low <= 1 && q >= -17 && q <= 10 && (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == high)
+        answer.mantissa &= ~1ull;
+
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (2ull << 23)) 
+    {
+        answer.mantissa = 1ull << 23;
+        answer.power2++;
+    }
+    answer.mantissa &= ~(1ull << 23);
+    if (answer.power2 >= 0xFF) { answer.power2 = 0xFF; answer.mantissa = 0; }
+    return answer;
+}
 
-    double num = 0.0;
+// minimal big integer for the slow path, little endian 32 bit limbs
+struct ABigInt 
+{
+    uint32_t limbs[64]; 
+    int count; 
+};
 
-    while (IsNumber(*ptr)) 
-        num = 10.0 * num + (double)(*ptr++ - '0');
+inline void BigIntMulAdd(ABigInt& x, uint32_t mul, uint32_t add)
+{
+    uint64_t carry = add;
+    for (int i = 0; i < x.count; i++)
+    {
+        carry += (uint64_t)x.limbs[i] * mul;
+        x.limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry && x.count < 64) x.limbs[x.count++] = (uint32_t)carry;
+}
 
-    if (*ptr == '.') ptr++;
+inline void BigIntPow5(ABigInt& x, int n)
+{
+    for (; n >= 13; n -= 13) BigIntMulAdd(x, 1220703125u, 0); // 5^13
+    uint32_t rest = 1;
+    while (n-- > 0) rest *= 5;
+    BigIntMulAdd(x, rest, 0);
+}
 
-    double fra = 0.0, div = 1.0;
+inline void BigIntShiftLeft(ABigInt& x, int n)
+{
+    int words = n >> 5, bits = n & 31;
+    if (x.count == 0 || n == 0) return;
+    int newCount = MIN(x.count + words + 1, 64);
+    for (int i = newCount - 1; i >= words; i--)
+    {
+        int src = i - words;
+        uint32_t hi = src < x.count ? x.limbs[src] : 0u;
+        uint32_t lo = src > 0 && src - 1 < x.count ? x.limbs[src - 1] : 0u;
+        x.limbs[i] = bits ? (hi << bits) | (lo >> (32 - bits)) : hi;
+    }
+    for (int i = 0; i < words && i < 64; i++) x.limbs[i] = 0u;
+    x.count = newCount;
+    while (x.count > 0 && x.limbs[x.count - 1] == 0) x.count--;
+}
 
-    while (IsNumber(*ptr) && div < 1.0e9) // 1e8 is 1 and 8 zero 1000000000
-        fra = 10.0f * fra + (double)(*ptr++ - '0'), div *= 10.0f;
+inline int BigIntCompare(const ABigInt& a, const ABigInt& b)
+{
+    if (a.count != b.count) return a.count < b.count ? -1 : 1;
+    for (int i = a.count - 1; i >= 0; i--)
+        if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1;
+    return 0;
+}
 
-    num += fra / div;
+// when more than 19 digits are truncated and Eisel-Lemire can't decide between two floats
+// we compare decimal digits with the halfway point between them using big integers.
+// 114 digits is enough for floats, remaining digits only tells us value is above the halfway
+inline AFloatBits FloatSlowPath(const char* digits, int exp10, AFloatBits lower)
+{
+    ABigInt decimal; decimal.count = 0;
+    int numDigits = 0;
+    bool truncated = false, fraction = false;
+    
+    for (const char* ptr = digits; IsNumber(*ptr) || *ptr == '.'; ptr++)
+    {
+        if (*ptr == '.') { fraction = true; continue; }
+        if (numDigits == 0 && *ptr == '0') { exp10 -= fraction; continue; }
+        
+        if (numDigits < 128) BigIntMulAdd(decimal, 10, *ptr - '0'), numDigits++, exp10 -= fraction;
+        else truncated |= *ptr != '0', exp10 += !fraction;
+    }
 
-    while (IsNumber(*ptr)) ptr++;
+    // halfway = (2 * m + 1) * 2^(e - 1)
+    uint64_t significand = lower.power2 == 0 ? lower.mantissa : lower.mantissa | (1ull << 23);
+    int power2 = (lower.power2 == 0 ? 1 : lower.power2) - 127 - 23 - 1;
+    ABigInt halfway; halfway.count = 1;
+    halfway.limbs[0] = (uint32_t)(significand * 2 + 1);
 
-    if (*ptr == 'e' || *ptr == 'E') // exponent
+    // compare decimal * 5^e * 2^e with halfway * 2^power2
+    int decimalPow2 = exp10;
+    if (exp10 >= 0) BigIntPow5(decimal, exp10);
+    else            BigIntPow5(halfway, -exp10), power2 -= exp10, decimalPow2 = 0;
+    
+    int minPow2 = MIN(decimalPow2, power2);
+    BigIntShiftLeft(decimal, decimalPow2 - minPow2);
+    BigIntShiftLeft(halfway, power2 - minPow2);
+    
+    int cmp = BigIntCompare(decimal, halfway);
+    bool roundUp = cmp > 0 || (cmp == 0 && (truncated || (significand & 1)));
+    if (!roundUp) return lower;
+    
+    lower.mantissa++;
+    if (lower.mantissa == (1ull << 23)) // overflowed to next exponent, or subnormal to normal
     {
-        ptr++;
-        const double* powers;
+        lower.mantissa = 0;
+        lower.power2++;
+    }
+    return lower;
+}
 
-        switch (*ptr)
-        {
-            case '+': powers = POWER_10_POS; ptr++; break;
-            case '-': powers = POWER_10_NEG; ptr++; break;
-            default:  powers = POWER_10_POS;        break;
-        }
+inline float ParseFloat(const char*& text)
+{
+    const float POWER_10[11] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+    
+    const char* ptr = text;
+    while (!IsNumber(*ptr) && *ptr != '-') ptr++;
+	
+    bool negative = *ptr == '-';
+    ptr += negative;
+
+    const char* digits = ptr;
+    uint64_t w = 0;
+    int numDigits = 0, exp10 = 0; // value is w * 10^exp10
 
-        int eval = 0;
-        while (IsNumber(*ptr))
-            eval = 10 * eval + (*ptr++ - '0');
+    while (*ptr == '0') ptr++; // leading zeros are not significant
+    
+    for (; IsNumber(*ptr); ptr++, numDigits++)
+        if (numDigits < 19) w = w * 10 + (*ptr - '0'); else exp10++;
+
+    if (*ptr == '.') 
+    {
+        ptr++;
+        if (numDigits == 0) 
+            for (; *ptr == '0'; ptr++) exp10--;
 
-        num *= (eval >= MAX_POWER) ? 0.0 : powers[eval];
+        for (; IsNumber(*ptr); ptr++, numDigits++)
+            if (numDigits < 19) w = w * 10 + (*ptr - '0'), exp10--;
     }
 
+    int exponent = 0;
+    if (*ptr == 'e' || *ptr == 'E')
+    {
+        ptr++;
+        bool negativeExp = *ptr == '-';
+        ptr += *ptr == '-' || *ptr == '+';
+        
+        for (; IsNumber(*ptr); ptr++)
+            if (exponent < 100000) exponent = 10 * exponent + (*ptr - '0');
+        
+        exponent = negativeExp ? -exponent : exponent;
+        exp10 += exponent;
+    }
+    
     text = ptr;
-    return (float)(sign * num);
+    // fast path, both w and power of ten is exact in float so single operation is correctly rounded
+    if (numDigits <= 19 && w <= (1ull << 24) && exp10 >= -10 && exp10 <= 10)
+    {
+        float value = (float)w;
+        value = exp10 < 0 ? value / POWER_10[-exp10] : value * POWER_10[exp10];
+        return negative ? -value : value;
+    }
+    
+    AFloatBits bits = EiselLemire(exp10, w);
+    if (numDigits > 19 && bits.power2 != 0xFF)
+    {
+        AFloatBits upper = EiselLemire(exp10, w + 1);
+        if (upper.mantissa != bits.mantissa || upper.power2 != bits.power2) 
+            bits = FloatSlowPath(digits, exponent, bits);
+    }
+
+    uint32_t result = (uint32_t)bits.mantissa | ((uint32_t)bits.power2 << 23) | ((uint32_t)negative << 31);
+    return BitCast<float>(result);
 }
 
 #ifndef AX_NO_UNROLL
@@ -1342,6 +1827,16 @@ struct FixedSizeGrowableAllocator
         return result;
     }
 
+    // links fragments of other to the end of ours, nothing is copied and pointers to other's memory stays valid
+    void Append(FixedSizeGrowableAllocator& other)
+    {
+        if (!other.base) return;
+        current->next   = other.base;
+        current         = other.current;
+        currentCapacity = other.currentCapacity;
+        other.base = other.current = nullptr;
+    }
+
     void CheckFixGrow(int count)
     {
         if (current->size + count >= currentCapacity)
@@ -1431,13 +1926,13 @@ struct Array
 	}
 
 	Array(int _capacity, int _count)
-		: m_capacity(_capacity), m_count(_count)
+		: m_count(_count), m_capacity(_capacity)
 	{
 		arr = allocator.Allocate(m_capacity);
 	}
 
 	Array(int _count, const ValueT& val)
-		: m_capacity(_count + (_count / 2)), m_count(_count)
+		: m_count(_count), m_capacity(_count + (_count / 2))
 	{
 		arr = allocator.AllocateUninitialized(m_capacity);
 		FillN(arr, val, m_count);
@@ -1691,11 +2186,16 @@ struct Array
 		Swap(arr[index], arr[--m_count]);
 	}
 
+	// allocates exactly _size elements, Add doesn't reallocate until count exceeds it
 	void Reserve(int _size)
 	{
 		if (_size > m_capacity)
 		{
-			GrowIfNecessary(_size);
+			if (arr) // array can be nullptr (first initialization)
+				arr = allocator.Reallocate(arr, m_capacity, _size);
+			else
+				arr = allocator.Allocate(_size);
+			m_capacity = _size;
 		}
 	}
 
@@ -1827,6 +2327,18 @@ inline void SBFree(void* a) { if (a) FreeAligned(((int*)a)-2); }
 
 inline int SBCount(void* a) { if (!a) return 0; return *((int*)a - 1); }
 
+// allocates exactly capacity elements, b must be null
+template<typename T>
+inline void SBReserve(T*& b, int capacity)
+{
+	constexpr int twoIntSize = sizeof(int) + sizeof(int);
+	ASSERT(b == nullptr);
+	T* a = (T*)AllocAligned(sizeof(T) * capacity + twoIntSize, alignof(T));
+	((int*)a)[0] = capacity;
+	((int*)a)[1] = 0;
+	b = (T*)((int*)a+2);
+}
+
 template<typename T>
 inline void SBPush(T*& b, const T& v)
 {
@@ -1842,12 +2354,12 @@ inline void SBPush(T*& b, const T& v)
 
 	int* arr = ((int*)a);
 	int size = arr[-1], capacity = arr[-2];
-	if (size + 1 >= capacity)
+	if (size >= capacity)
 	{
 		int* old = arr-2;
-		int newCapacity = CalculateArrayGrowth(capacity);
+		int newCapacity = CalculateArrayGrowth(size + 1);
 		a = (T*)AllocAligned(newCapacity * sizeof(T) + twoIntSize, alignof(T));
-		MemCpy<alignof(T)>(a, old, capacity * sizeof(T) + twoIntSize);
+		MemCpy<alignof(T)>(a, old, size * sizeof(T) + twoIntSize); // only used part
 		FreeAligned(old);
 		a = (T*)((int*)a+2);
 		arr = ((int*)a);
@@ -1891,8 +2403,8 @@ __forceinline __constexpr float SqrtConstexpr(float a) {
 __forceinline float Sqrt(float a) {
 #ifdef AX_SUPPORT_SSE
 	return _mm_cvtss_f32(_mm_sqrt_ps(_mm_set_ps1(a)));
-#elif defined(__clang__)
-	return __builtin_sqrt(a);
+#elif defined(__clang__) || defined(__GNUC__)
+	return __builtin_sqrtf(a);
 #else
 	return SqrtConstexpr(a);
 #endif
@@ -2279,6 +2791,11 @@ struct GLTFAccessor
     int count;
     int byteOffset;
     int type; // 1 = SCALAR, 2 = VEC2, 3 = VEC3, 4 = VEC4, mat4
+    short hasBounds;     // bit 1 min, bit 2 max is given
+    short hasBufferView; // sparse accessors might not have buffer view, their base is zero
+    float min[3]; // first three components of min and max, enough for positions
+    float max[3];
+    const char* sparse; // sparse object in json, parsed after accessors and buffer views
 };
 
 struct GLTFBufferView
@@ -2312,392 +2829,1273 @@ bool StrCmp16(const char* RESTRICT a, const char* b, uint64_t bSize)
     return equal;
 }
 
-inline const char* SkipUntill(const char* curr, char character)
-{
-    AX_NO_UNROLL while (*curr != character) curr++;
-    return curr;
-}
+/*****************************************************************
+*                         Keyword Hashing                        *
+*****************************************************************/
 
-inline const char* SkipAfter(const char* curr, char character)
+// keys of each json object are matched with a perfect hash that is generated at compile time.
+// hash uses length and two words of the key, so each key costs one hash and one compare.
+// FindKeyword returns index of the key in the keyword list or -1 if it is unknown, 
+// Index gives the same index at compile time so it can be used in case labels
+
+// keys shorter than 16 characters are zero padded into two words, 
+// longer keys use the first and the last 8 characters
+constexpr uint64_t KeywordWord(const char* str, int length)
 {
-    AX_NO_UNROLL while (*curr++ != character);
-    return curr;
+    uint64_t word = 0ull;
+    for (int i = 0; i < length && i < 8; i++)
+        word |= uint64_t((unsigned char)str[i]) << (i * 8);
+    return word;
 }
 
-__private const char* CopyStringInQuotes(char*& str, const char* curr, AStringAllocator& stringAllocator)
+constexpr uint64_t KeywordHighWord(const char* str, int length)
 {
-    while (*curr != '"') curr++; // find quote
-    curr++; // skip "
-    // get length in quotes
-    const char* quote = curr;
-    while (*quote != '"') quote++;
-    int len = (int)(quote - curr);
-    char* alloc = stringAllocator.AllocateUninitialized(len + 16);
-    str = alloc;
-    SmallMemCpy(alloc, curr, len);
-    alloc += len;
-    curr  += len;
-    *alloc = '\0'; // null terminate
-    return ++curr;// skip quote
+    return length < 16 ? KeywordWord(str + 8, length - 8) : KeywordWord(str + length - 8, 8);
 }
 
-__private const char* GetStringInQuotes(char* str, const char* curr)
+constexpr uint32_t KeywordHash(uint64_t low, uint64_t high, int length, uint64_t seed, int shift)
 {
-    ++curr; // skip quote " 
-    AX_NO_UNROLL while (*curr != '"') *str++ = *curr++;
-    *str = '\0'; // null terminate
-    return ++curr;
+    return uint32_t(((low ^ ((high << 29) | (high >> 35)) ^ uint64_t(length)) * seed) >> shift);
 }
 
-__private const char* HashStringInQuotes(uint64_t* hash, const char* curr)
+constexpr bool KeywordEqual(const char* a, const char* b)
 {
-    ++curr; // skip quote " 
-    uint64_t h = 0ull;
-    uint64_t shift = 0;
-    AX_NO_UNROLL while (*curr != '"' && shift < 64) { h |= uint64_t(*curr++) << shift; shift += 8; }
-    *hash = h;
-    return ++curr;
+    while (*a && *a == *b) a++, b++;
+    return *a == *b;
 }
 
-// most 8 characters
-constexpr uint64_t AHashString8(const char* curr)
+// not constexpr, called only if there is no perfect hash for the keywords, so compilation fails
+inline void KeywordTableHasNoPerfectHash() {}
+
+template<int N>
+struct AKeywordTable
 {
-    uint64_t h = 0ull;
-    uint64_t shift = 0;
+    static constexpr int Size  = N <= 4 ? 16 : N <= 8 ? 32 : N <= 16 ? 64 : 128; 
+    static constexpr int Shift = Size == 16 ? 60 : Size == 32 ? 59 : Size == 64 ? 58 : 57;
+    
+    uint64_t    words[N + 1][2]; // last one is all ones, empty slots point to it
+    uint64_t    seed;
+    const char* names[N];
+    int         lengths[N];
+    uint8_t     slots[Size];
+
+    constexpr AKeywordTable(const char* const (&keywords)[N]) 
+    : words{}, seed(0), names{}, lengths{}, slots{}
+    {
+        for (int i = 0; i < N; i++)
+        {
+            int length = 0;
+            while (keywords[i][length]) length++;
+            names[i]    = keywords[i];
+            lengths[i]  = length;
+            words[i][0] = KeywordWord(keywords[i], length);
+            words[i][1] = KeywordHighWord(keywords[i], length);
+        }
+        words[N][0] = words[N][1] = ~0ull;
+
+        // try seeds until there is no collision
+        for (uint64_t attempt = 1; attempt < 4096 && seed == 0; attempt++)
+        {
+            uint64_t candidate = (attempt * 0x9E3779B97F4A7C15ull) | 1ull;
+            bool collision = false;
+            for (int i = 0; i < Size; i++) slots[i] = N;
 
-    while (*curr != '\0') 
-    { 
-        h |= uint64_t(*curr++) << shift; 
-        shift += 8; 
+            for (int i = 0; i < N && !collision; i++)
+            {
+                uint32_t slot = KeywordHash(words[i][0], words[i][1], lengths[i], candidate, Shift);
+                collision = slots[slot] != N;
+                slots[slot] = (uint8_t)i;
+            }
+            if (!collision) seed = candidate;
+        }
+        if (seed == 0) KeywordTableHasNoPerfectHash();
     }
-    return h;
-}
 
-__private const char* SkipToNextNode(const char* curr, char open, char close)
-{
-    int balance = 1;
-    // skip to first open brackets
-    AX_NO_UNROLL while (*curr++ != open);
+    constexpr int Index(const char* name) const
+    {
+        for (int i = 0; i < N; i++)
+            if (KeywordEqual(names[i], name)) return i;
+        return -1;
+    }
+};
 
-    while (*curr && balance > 0)
+// number of characters until closing quote (or null terminator)
+__forceinline int KeywordLength(const char* key)
+{
+    const char* start = key;
+    while (true)
     {
-        balance += *curr == open;
-        balance -= *curr++ == close;
+        uint64_t word   = UnalignedLoad64(key);
+        uint64_t quotes = word ^ 0x2222222222222222ull; // '"' bytes are zero
+        uint64_t found  = ((quotes - 0x0101010101010101ull) & ~quotes) | ((word - 0x0101010101010101ull) & ~word);
+        found &= 0x8080808080808080ull;
+        if (found) return (int)(key - start) + (int)(TrailingZeroCount64(found) >> 3);
+        key += 8;
     }
-    return curr;
 }
 
-__private const char* ParseFloat16(const char*& curr, short& flt)
+template<int N>
+inline int FindLongKeyword(const AKeywordTable<N>& table, const char* key, int length)
 {
-    flt = (short)(ParseFloat(curr) * 400.0f);
-    return curr;
+    uint64_t low = UnalignedLoad64(key), high = 0ull;
+    if (length < 8)  low &= (1ull << (length * 8)) - 1ull;
+    if (length > 8)  high = UnalignedLoad64(key + 8);
+    if (length < 16) high &= ~0ull >> (MAX(16 - length, 0) * 8 & 63);
+    if (length >= 16) high = UnalignedLoad64(key + length - 8);
+    
+    int index = table.slots[KeywordHash(low, high, length, table.seed, AKeywordTable<N>::Shift)];
+    if (index == N || table.lengths[index] != length || table.words[index][0] != low || table.words[index][1] != high)
+        return -1;
+    
+    for (int i = 8; i < length - 8; i++) // middle of the long keys
+        if (key[i] != table.names[index][i]) return -1;
+    return index;
 }
 
-__private const char* ParseAccessors(const char* curr, Array<GLTFAccessor>& accessorArray)
+// high bit of the first '"' byte is set, bytes after it might have false positives
+__forceinline uint64_t KeywordQuotes(uint64_t word)
 {
-    GLTFAccessor accessor{};
-    curr += 10; // skip accessors"
-    // read each accessor
-    while (true)
-    {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}') // next accessor
-            {
-                accessorArray.Add(accessor);
-                MemsetZero(&accessor, sizeof(GLTFAccessor));
-            }
-
-            if (*curr == ']') // end all accessors
-            return ++curr;
-            curr++;
-        }
-        ASSERT(*curr != '\0' && "parsing accessors failed probably you forget to close brackets!");
-        curr++;
-        if (StrCMP16(curr, "bufferView"))         accessor.bufferView = ParsePositiveNumber(curr);
-        else if (StrCMP16(curr, "byteOffset"))    accessor.byteOffset = ParsePositiveNumber(curr);
-        else if (StrCMP16(curr, "componentType")) accessor.componentType = ParsePositiveNumber(curr) - 0x1400; // GL_BYTE 
-        else if (StrCMP16(curr, "count"))         accessor.count = ParsePositiveNumber(curr);
-        else if (StrCMP16(curr, "name"))
-        {
-            curr += sizeof("name'"); // we don't need accessor's name
-            int numQuotes = 0;
-            // skip two quotes
-            while (numQuotes < 2)
-                numQuotes += *curr++ == '"';
-        }
-        else if (StrCMP16(curr, "type"))
-        {
-            curr += sizeof("type'"); // skip type
-            curr = SkipUntill(curr, '"');
-            uint64_t hash;
-            curr = HashStringInQuotes(&hash, curr);
-            
-            switch (hash)
-            {   case AHashString8("SCALAR"): accessor.type = 1; break;
-                case AHashString8("VEC2"):   accessor.type = 2; break;
-                case AHashString8("VEC3"):   accessor.type = 3; break;
-                case AHashString8("VEC4"):   accessor.type = 4; break;
-                case AHashString8("MAT4"):   accessor.type = 16;break;
-                default: ASSERT(0 && "Unknown accessor type");
-            };
-        }
-        else if (StrCMP16(curr, "min")) curr = SkipToNextNode(curr, '[', ']'); // skip min and max
-        else if (StrCMP16(curr, "max")) curr = SkipToNextNode(curr, '[', ']');
-        else if (StrCMP16(curr, "normalized")) curr = SkipAfter(curr, '"');
-        else
-        {
-            ASSERT(0 && "unknown accessor var");
-            return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
-        }
-    }
+    uint64_t quotes = word ^ 0x2222222222222222ull; // '"' bytes are zero
+    return (quotes - 0x0101010101010101ull) & ~quotes & 0x8080808080808080ull;
 }
 
-__private const char* ParseBufferViews(const char* curr, Array<GLTFBufferView>& bufferViews)
+// key is the text after the opening quote
+template<int N>
+__forceinline int FindKeyword(const AKeywordTable<N>& table, const char* key)
 {
-    GLTFBufferView bufferView{};
-    curr += sizeof("bufferViews'");
-
-    // read each buffer view
-    while (true)
+    // most of the keys are shorter than 16 characters, two words are enough
+    uint64_t low = UnalignedLoad64(key), high = 0ull;
+    uint64_t quotes = KeywordQuotes(low);
+    int length;
+    if (quotes) 
     {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}') // next buffer view
-            {
-                bufferViews.Add(bufferView);
-                MemsetZero(&bufferView, sizeof(GLTFBufferView));
-            }
-            if (*curr++ == ']') return curr; // end all buffer views
-        }
-        ASSERT(*curr != '0' && "buffer view parse failed, probably you forgot to close brackets!");
+        length = (int)(TrailingZeroCount64(quotes) >> 3);
+        low &= ~(~0ull << (length * 8));
+    }
+    else
+    {
+        high   = UnalignedLoad64(key + 8);
+        quotes = KeywordQuotes(high);
+        if (!quotes) return FindLongKeyword(table, key, KeywordLength(key));
+        int highLength = (int)(TrailingZeroCount64(quotes) >> 3);
+        high  &= ~(~0ull << (highLength * 8));
+        length = highLength + 8;
+    }
 
-        uint64_t hash;
-        curr = HashStringInQuotes(&hash, curr);
+    int index = table.slots[KeywordHash(low, high, length, table.seed, AKeywordTable<N>::Shift)];
+    // empty slot is all ones, there are no 0xFF bytes in utf8 so it can't be equal
+    return table.words[index][0] == low && table.words[index][1] == high ? index : -1;
+}
 
-        switch (hash)
-        {
-            case AHashString8("buffer"):    bufferView.buffer = ParsePositiveNumber(++curr); break; 
-            case AHashString8("byteOffs"):  bufferView.byteOffset = ParsePositiveNumber(++curr); break; 
-            case AHashString8("byteLeng"):  bufferView.byteLength = ParsePositiveNumber(++curr); break; 
-            case AHashString8("byteStri"):  bufferView.byteStride = ParsePositiveNumber(++curr); break; 
-            case AHashString8("target"):    bufferView.target = ParsePositiveNumber(++curr); break;
-            case AHashString8("name"):  {
-                int numQuote = 0;
-                while (numQuote < 2)
-                    numQuote += *curr++ == '"';
-                break;
-            }
-            default: {
-                ASSERT(0 && "UNKNOWN buffer view value!");
-                return (const char*)AError_UNKNOWN_BUFFER_VIEW_VAR;
-            }
-        };
-    }
+/*****************************************************************
+*                      Structural Scanning                       *
+*****************************************************************/
+
+// json is classified 64 bytes at a time into bitmasks, similar to the first stage of simdjson.
+// blocks start at the scan position and are loaded unaligned. json text is followed by AReadPadding zeros,
+// scanners stop at the first block that has the null terminator, so we don't need tail checks.
+
+struct AJsonBlock
+{
+#if defined(AX_SUPPORT_AVX2)
+    __m256i lo, hi;
+#elif defined(AX_ARM) && defined(__aarch64__)
+    uint8x16_t v[4];
+#else
+    const char* ptr;
+#endif
+};
+
+inline AJsonBlock LoadJsonBlock(const char* ptr)
+{
+    AJsonBlock block;
+#if defined(AX_SUPPORT_AVX2)
+    block.lo = _mm256_loadu_si256((const __m256i*)ptr);
+    block.hi = _mm256_loadu_si256((const __m256i*)(ptr + 32));
+#elif defined(AX_ARM) && defined(__aarch64__)
+    for (int i = 0; i < 4; i++) block.v[i] = vld1q_u8((const uint8_t*)ptr + i * 16);
+#else
+    block.ptr = ptr;
+#endif
+    return block;
 }
 
-static void DecodeBase64(char *dst, const char *src, size_t src_length)
+// one bit for each byte that is equal to c
+inline uint64_t JsonBlockEq(const AJsonBlock& block, char c)
 {
-    struct Base64Table
+#if defined(AX_SUPPORT_AVX2)
+    __m256i cv = _mm256_set1_epi8(c);
+    uint64_t lo = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block.lo, cv));
+    uint64_t hi = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block.hi, cv));
+    return lo | (hi << 32);
+#elif defined(AX_ARM) && defined(__aarch64__)
+    // neon doesn't have movemask, we are reducing with pairwise adds like simdjson
+    const uint8x16_t bits = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t cv = vdupq_n_u8((uint8_t)c);
+    uint8x16_t t0 = vandq_u8(vceqq_u8(block.v[0], cv), bits);
+    uint8x16_t t1 = vandq_u8(vceqq_u8(block.v[1], cv), bits);
+    uint8x16_t t2 = vandq_u8(vceqq_u8(block.v[2], cv), bits);
+    uint8x16_t t3 = vandq_u8(vceqq_u8(block.v[3], cv), bits);
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(t0, t1), vpaddq_u8(t2, t3));
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i++) 
+        mask |= uint64_t(block.ptr[i] == c) << i;
+    return mask;
+#endif
+}
+
+// each bit is xor of all bits before it (including itself), converts quote bits to inside string bits
+inline uint64_t PrefixXor(uint64_t x)
+{
+    x ^= x << 1;  x ^= x << 2;  x ^= x << 4;
+    x ^= x << 8;  x ^= x << 16; x ^= x << 32;
+    return x;
+}
+
+// removes quotes that are escaped with backslash. escaped is carried to the next block if last char is backslash
+inline uint64_t UnescapedQuotes(uint64_t quotes, uint64_t backslashes, uint64_t* escapeCarry)
+{
+    uint64_t escaped = *escapeCarry;
+    *escapeCarry = 0;
+    // backslashes are rare in gltf, process them one by one
+    while (backslashes)
     {
-        uint8_t table[256] = { 0 };
-        constexpr Base64Table()
-        {
-            for (char c = 'A'; c <= 'Z'; c++) table[c] = (uint8_t)(c - 'A');
-            for (char c = 'a'; c <= 'z'; c++) table[c] = (uint8_t)(26 + (c - 'a'));
-            for (char c = '0'; c <= '9'; c++) table[c] = (uint8_t)(52 + (c - '0'));
-            table['+'] = 62;
-            table['/'] = 63;
-        }
-    };
-    
-    static constexpr Base64Table table{};
-    
-    for (uint64_t i = 0; i + 4 <= src_length; i += 4) {
-        uint32_t a = table.table[src[i + 0]];
-        uint32_t b = table.table[src[i + 1]];
-        uint32_t c = table.table[src[i + 2]];
-        uint32_t d = table.table[src[i + 3]];
-           
-        dst[0] = (char)(a << 2 | b >> 4);
-        dst[1] = (char)(b << 4 | c >> 2);
-        dst[2] = (char)(c << 6 | d);
-        dst += 3;
+        int i = (int)TrailingZeroCount64(backslashes);
+        backslashes &= backslashes - 1;
+        if ((escaped >> i) & 1) continue; // escaped backslash
+        if (i == 63) *escapeCarry = 1;
+        else escaped |= 1ull << (i + 1);
     }
+    return quotes & ~escaped;
 }
 
-__private const char* ParseBuffers(const char* curr, const char* path, Array<GLTFBuffer>& bufferArray)
+// walks json block by block and keeps track of strings between blocks
+struct AJsonScanner
 {
-    GLTFBuffer buffer{};
-    curr += sizeof("buffers'"); // skip buffers"
-    char binFilePath[256]={0};
-    char* endOfWorkDir = binFilePath;
-    int binPathlen = StringLength(path);
-    SmallMemCpy(binFilePath, path, binPathlen);
-    endOfWorkDir = binFilePath + binPathlen;
-    
-    // remove bla.gltf
-    while (binFilePath[binPathlen - 1] != '/' && binFilePath[binPathlen - 1] != '\\')
-        binFilePath[--binPathlen] = '\0', endOfWorkDir--;
+    const char* block;
+    uint64_t inString;    // all ones if previous block ended inside of string
+    uint64_t escapeCarry; // last character of the previous block was an unescaped backslash
+};
 
-    // read each buffer
+// brackets of the block that are not in strings, bit i is block[i]
+struct AJsonBrackets
+{
+    uint64_t openObjects, closeObjects;
+    uint64_t openArrays, closeArrays;
+    uint64_t nulls;
+};
+
+inline AJsonScanner BeginJsonScan(const char* curr)
+{
+    AJsonScanner scanner;
+    scanner.block = curr;
+    scanner.inString = 0;
+    scanner.escapeCarry = 0;
+    return scanner;
+}
+
+// classifies the current block, call NextJsonBlock to continue with the next one
+inline AJsonBrackets ScanJsonBlock(AJsonScanner& scanner)
+{
+    AJsonBlock b = LoadJsonBlock(scanner.block);
+    uint64_t quotes = UnescapedQuotes(JsonBlockEq(b, '"'), JsonBlockEq(b, '\\'), &scanner.escapeCarry);
+    uint64_t strings = PrefixXor(quotes) ^ scanner.inString;
+    scanner.inString = (uint64_t)((int64_t)strings >> 63); // broadcast last bit
+
+    AJsonBrackets brackets;
+    brackets.openObjects  = JsonBlockEq(b, '{') & ~strings;
+    brackets.closeObjects = JsonBlockEq(b, '}') & ~strings;
+    brackets.openArrays   = JsonBlockEq(b, '[') & ~strings;
+    brackets.closeArrays  = JsonBlockEq(b, ']') & ~strings;
+    brackets.nulls        = JsonBlockEq(b, '\0');
+    return brackets;
+}
+
+inline void NextJsonBlock(AJsonScanner& scanner)
+{
+    scanner.block += 64;
+}
+
+// returns pointer to first character that is one of chars or null terminator, strings are not skipped
+template<int N>
+__forceinline const char* FindFirstOf(const char* curr, const char (&chars)[N])
+{
     while (true)
     {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}') // next buffer
-            {
-                bufferArray.Add(buffer);
-                MemsetZero(&buffer, sizeof(GLTFBuffer));
-                MemsetZero(endOfWorkDir, sizeof(binFilePath) - (size_t)(endOfWorkDir - binFilePath));
-            }
+        AJsonBlock b = LoadJsonBlock(curr);
+        uint64_t mask = JsonBlockEq(b, '\0');
+        for (int i = 0; i < N; i++)
+            mask |= JsonBlockEq(b, chars[i]);
+        if (mask) return curr + TrailingZeroCount64(mask);
+        curr += 64;
+    }
+}
 
-            if (*curr++ == ']') return curr; // end all buffers
-        }
-        ASSERT(*curr && "parsing buffers failed, probably you forgot to close braces");
-        curr++;
-        if (StrCMP16(curr, "uri")) // is uri
-        {
-            curr += sizeof("uri'"); // skip uri": 
-            while (*curr != '"') curr++;
-            if (StartsWith(curr, "\"data:"))
-            {
-                curr = SkipAfter(curr, ',');
-                uint64_t base64Size = 0;
-                while (curr[base64Size] != '\"') {
-                    base64Size++;
-                }
-                buffer.uri = AX_MALLOC(base64Size);
-                DecodeBase64((char*)buffer.uri, curr, base64Size);
-                curr += base64Size + 1;
-            }
-            else
-            {
-                curr = GetStringInQuotes(endOfWorkDir, curr);
-                buffer.uri = ReadAllFile(binFilePath);
-                ASSERT(buffer.uri && "uri is not exist");
-                if (!buffer.uri) return (const char*)AError_BIN_NOT_EXIST;
-            }
-        }
-        else if (StrCMP16(curr, "byteLength"))
+// returns pointer to first character c or null terminator
+inline const char* SkipUntill(const char* curr, char c)
+{
+    if (*curr == c) return curr; // most of the time character is close, don't bother with vector
+    const char chars[1] = { c };
+    return FindFirstOf(curr, chars);
+}
+
+inline const char* SkipAfter(const char* curr, char character)
+{
+    curr = SkipUntill(curr, character);
+    return curr + (*curr != '\0');
+}
+
+// returns pointer to next '"', '{', '}', '[', ']' or null terminator. curr must be outside of string,
+// used for skipping whitespace, numbers, commas etc. when we are searching for next key or end of the object
+inline const char* NextStructural(const char* curr)
+{
+    static constexpr char structurals[5] = { '"', '{', '}', '[', ']' };
+    return FindFirstOf(curr, structurals);
+}
+
+__private const char* CopyStringInQuotes(char*& str, const char* curr, AStringAllocator& stringAllocator)
+{
+    while (*curr != '"') curr++; // find quote
+    curr++; // skip "
+    // get length in quotes
+    const char* quote = curr;
+    while (*quote != '"') quote++;
+    int len = (int)(quote - curr);
+    char* alloc = stringAllocator.AllocateUninitialized(len + 16);
+    str = alloc;
+    SmallMemCpy(alloc, curr, len);
+    alloc += len;
+    curr  += len;
+    *alloc = '\0'; // null terminate
+    return ++curr;// skip quote
+}
+
+__private const char* GetStringInQuotes(char* str, const char* curr)
+{
+    ++curr; // skip quote " 
+    AX_NO_UNROLL while (*curr != '"') *str++ = *curr++;
+    *str = '\0'; // null terminate
+    return ++curr;
+}
+
+// skips to first open bracket('{' or '[') and returns pointer after it's matching close bracket
+// brackets in strings are ignored
+__private const char* SkipToNextNode(const char* curr, char open)
+{
+    curr = SkipAfter(curr, open);
+    if (curr[-1] != open) return curr; // null terminator
+
+    ASSERT(open == '{' || open == '[');
+    AJsonScanner scanner = BeginJsonScan(curr);
+    int balance = 1;
+    
+    while (true)
+    {
+        AJsonBrackets b = ScanJsonBlock(scanner);
+        const char* block = scanner.block;
+        uint64_t opens  = open == '{' ? b.openObjects  : b.openArrays;
+        uint64_t closes = open == '{' ? b.closeObjects : b.closeArrays;
+        uint64_t nulls  = b.nulls;
+        
+        // whole block can't close the node, skip it
+        if (nulls == 0 && balance + (int)PopCount64(opens) - (int)PopCount64(closes) > 0 && 
+            balance - (int)PopCount64(closes) > 0)
         {
-            buffer.byteLength = ParsePositiveNumber(++curr);
+            balance += (int)PopCount64(opens) - (int)PopCount64(closes);
+            NextJsonBlock(scanner);
+            continue;
         }
-        else
+        
+        // walk brackets in order until balance is zero
+        uint64_t brackets = opens | closes | nulls;
+        while (brackets)
         {
-            ASSERT(0 && "Unknown buffer variable! byteLength or uri excepted.");
-            return (const char*)AError_BUFFER_PARSE_FAIL;
+            int i = (int)TrailingZeroCount64(brackets);
+            brackets &= brackets - 1;
+            uint64_t bit = 1ull << i;
+            if (nulls & bit) return block + i;
+            balance += (opens & bit) ? 1 : -1;
+            if (balance == 0) return block + i + 1;
         }
+        NextJsonBlock(scanner);
     }
 }
 
-// write paths to path buffer, buffer is seperated by null terminators
-__private const char* ParseImages(const char* curr, const char* path, Array<AImage>& images, AStringAllocator& stringAllocator)
+// elements of a big array are split into chunks that are parsed on different threads.
+// chunks know index of their first element, so output order is same as serial parsing
+static const int     AMaxArrayChunks       = 32;
+static const int64_t AMinParallelArraySize = 1 << 18; // smaller arrays are not worth creating threads
+
+struct AArrayChunk
 {
-    curr = SkipUntill(curr, '[');
-    curr++;
+    const char* begin; // '{' of the first element
+    int first;         // index of the first element
+    int count;
+};
+
+// walks brackets that are not in strings one by one, used by the array scanners below
+struct ABracketWalker
+{
+    AJsonScanner scanner;
+    const char* block;  // block of the remaining brackets
+    uint64_t remaining; // brackets of the block that are not returned yet
+    int depth;          // depth after the returned bracket, '[' of the array is 1
+};
+
+inline ABracketWalker BeginBracketWalk(const char* curr)
+{
+    ABracketWalker walker;
+    walker.scanner   = BeginJsonScan(curr);
+    walker.block     = curr;
+    walker.remaining = 0;
+    walker.depth     = 0;
+    return walker;
+}
+
+// returns pointer to the next '{', '[', '}', ']' or null terminator and updates the depth
+__forceinline const char* NextBracket(ABracketWalker& walker)
+{
+    while (walker.remaining == 0)
+    {
+        walker.block = walker.scanner.block;
+        AJsonBrackets b = ScanJsonBlock(walker.scanner);
+        NextJsonBlock(walker.scanner);
+        walker.remaining = b.openObjects | b.closeObjects | b.openArrays | b.closeArrays | b.nulls;
+    }
+    const char* bracket = walker.block + TrailingZeroCount64(walker.remaining);
+    walker.remaining &= walker.remaining - 1;
+    if (*bracket == '{' || *bracket == '[') walker.depth++;
+    else if (*bracket != '\0') walker.depth--;
+    return bracket;
+}
+
+// curr must point to '[' of the array. elements are found by walking brackets that are not in strings, 
+// each '{' in depth one starts an element. returns number of chunks, 0 if array is too small
+__private int SplitArray(const char* curr, int numThreads, AArrayChunk chunks[AMaxArrayChunks])
+{
+    int64_t size = (int64_t)(SkipToNextNode(curr, '[') - curr);
+    if (size < AMinParallelArraySize) return 0;
     
-    int pathLen = StringLength(path);
-    while (path[pathLen-1] != '/') pathLen--;
+    int numChunks = 0, numElements = 0;
+    // every chunk except the last one is bigger than chunkSize, so there are at most MIN(numThreads * 4, AMaxArrayChunks) chunks
+    int64_t chunkSize = size / MIN(numThreads * 4, AMaxArrayChunks) + 1;
+    const char* chunkEnd = curr; // next element after this starts a new chunk
 
-    AImage image{};
-    // read each buffer
+    ABracketWalker walker = BeginBracketWalk(curr);
     while (true)
     {
-        // search for name
-        while (*curr && *curr != '"')
-            if (*curr++ == ']')
-                return curr; // end all images
+        const char* element = NextBracket(walker);
+        if (*element == '\0') return 0; // not terminated, serial parser reports the error
+        if (walker.depth == 0) return numChunks;
+        if (walker.depth != 2 || *element != '{') continue;
         
-        ASSERT(*curr != '\0' && "parse images failed probably you forgot to close brackets");
-
-        curr++;
-        bool isUri = StrCMP16(curr, "uri");
-
-        // mimeType and name is not supported
-        if (isUri)
+        if (element >= chunkEnd)
         {
-            curr += 4;
-            curr = SkipAfter(curr, '"');
-            int uriSize = 0;
-            while (curr[uriSize] != '"') uriSize++;
-
-            image.path = stringAllocator.Allocate(uriSize + pathLen + 16);
-            SmallMemCpy(image.path, path, pathLen);
-            SmallMemCpy(image.path + pathLen, curr, uriSize);
-            image.path[uriSize + pathLen] = '\0';
-            curr += uriSize;
-            images.PushBack(image);
+            ASSERT(numChunks < AMaxArrayChunks);
+            chunks[numChunks].begin = element;
+            chunks[numChunks].first = numElements;
+            chunks[numChunks].count = 0;
+            numChunks++;
+            chunkEnd = element + chunkSize;
         }
+        chunks[numChunks - 1].count++;
+        numElements++;
     }
-    return nullptr;
 }
 
-__private const char* ParseTextures(const char* curr, Array<ATexture>& textures, AStringAllocator& stringAllocator)
+// counts objects of the array that starts at curr('[') without parsing them, so arrays can be allocated once.
+// if nestedCounts is not null, number of objects in the arrays of each element are added to it (primitives of meshes)
+__private int CountArrayElements(const char* curr, Array<int>* nestedCounts)
 {
-    curr += sizeof("textures'");
-    ATexture texture{};
+    ABracketWalker walker = BeginBracketWalk(curr);
+    uint64_t arrays = 0; // bit n is set if bracket in depth n is '['
+    int count = 0;
 
-    // read each buffer
     while (true)
     {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}') // next buffer view
-            {
-                textures.Add(texture);
-                MemsetZero(&texture, sizeof(ATexture));
-            }
+        const char* bracket = NextBracket(walker);
+        if (*bracket == '\0' || walker.depth == 0) return count;
+        if (*bracket == '}' || *bracket == ']') continue;
+            
+        uint64_t depthBit = 1ull << (walker.depth & 63);
+        if (*bracket == '[') { arrays |= depthBit; continue; }
+        arrays &= ~depthBit;
 
-            if (*curr == ']') // end all buffer views
-            return ++curr;
-            curr++;
-        }
-        ASSERT(*curr != '\0' && "parse images failed probably you forgot to close brackets");
-        curr++;
-        if (StrCMP16(curr, "sampler")) 
-        {
-            texture.sampler = ParsePositiveNumber(++curr);
-        }
-        else if (StrCMP16(curr, "source"))
+        // array is depth 1, elements are 2, nested arrays are 3 and their objects are 4
+        if (walker.depth == 2)
         {
-            texture.source = ParsePositiveNumber(++curr);
-        }
-        else if (StrCMP16(curr, "name"))
-        {
-            curr = CopyStringInQuotes(texture.name, curr + 5, stringAllocator);
-        }
-        else {
-            ASSERT(0 && "Unknown buffer variable! sampler, source or name excepted.");
-            return (const char*)AError_UNKNOWN_TEXTURE_VAR;
+            count++;
+            if (nestedCounts) nestedCounts->Add(0);
         }
+        else if (walker.depth == 4 && nestedCounts && (arrays & (1ull << 3)))
+            nestedCounts->Back()++;
     }
 }
 
-__private const char* ParseAttributes(const char* curr, APrimitive* primitive)
+// used by selective loading, elements that are out of the mask are not selected
+inline bool IsSelected(const Array<uint8_t>& mask, int index)
 {
-    curr += sizeof("attributes'");
+    return index >= 0 && index < mask.Size() && mask[index];
+}
 
-    while (true)
-    {
-        while (*curr != '"')
-        if (*curr++ == '}') return curr;
-        
-        curr++; // skip "
-        unsigned maskBefore = primitive->attributes;
-        if      (StrCMP16(curr, "POSITION"))   { primitive->attributes |= AAttribType_POSITION; }
-        else if (StrCMP16(curr, "NORMAL"))     { primitive->attributes |= AAttribType_NORMAL; }
-        else if (StrCMP16(curr, "TEXCOORD_0")) { primitive->attributes |= AAttribType_TEXCOORD_0; }
-        else if (StrCMP16(curr, "TANGENT"))    { primitive->attributes |= AAttribType_TANGENT; }
-        else if (StrCMP16(curr, "TEXCOORD_1")) { primitive->attributes |= AAttribType_TEXCOORD_1; }
-        else if (StrCMP16(curr, "JOINTS_0"))   { primitive->attributes |= AAttribType_JOINTS; }
-        else if (StrCMP16(curr, "WEIGHTS_0"))  { primitive->attributes |= AAttribType_WEIGHTS; }
-        else if (StrCMP16(curr, "TEXCOORD_"))  { curr = SkipAfter(curr, '"'); continue; } // < NO more than two texture coords
-        else { ASSERT(0 && "attribute variable unknown!"); return (const char*)AError_UNKNOWN_ATTRIB; }
+inline void Select(Array<uint8_t>& mask, int index)
+{
+    while (mask.Size() <= index) mask.Add(0);
+    mask[index] = 1;
+}
+
+__private const char* ParseFloat16(const char*& curr, short& flt)
+{
+    flt = (short)(ParseFloat(curr) * 400.0f);
+    return curr;
+}
+
+static constexpr const char* AAccessorKeys[] = { 
+    "bufferView", "byteOffset", "componentType", "count", "name", "type", "min", "max", "normalized", "sparse"
+};
+static constexpr const char* AAccessorTypeKeys[] = { "SCALAR", "VEC2", "VEC3", "VEC4", "MAT4" };
+static constexpr AKeywordTable<ArraySize(AAccessorKeys)>     AAccessorTable(AAccessorKeys);
+static constexpr AKeywordTable<ArraySize(AAccessorTypeKeys)> AAccessorTypeTable(AAccessorTypeKeys);
+
+// parses min or max array of the accessor, rest of the components after the first three are skipped.
+// returns error if the array is not closed
+__private const char* ParseAccessorBounds(const char* curr, float bounds[3])
+{
+    curr = SkipUntill(curr, '[');
+    if (*curr++ == '\0') return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+    for (int i = 0; ; i++)
+    {
+        while (*curr != ']' && *curr != '\0' && !IsNumber(*curr) && *curr != '-') curr++;
+        if (*curr == ']') return curr + 1;
+        ASSERT(*curr != '\0' && "accessor bounds are not closed");
+        if (*curr == '\0') return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+        float value = ParseFloat(curr);
+        if (i < 3) bounds[i] = value;
+    }
+}
+
+// parses members of one accessor, curr must be after the '{', returns pointer after the closing '}'
+__private const char* ParseAccessor(const char* curr, GLTFAccessor& accessor)
+{
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+            if (*curr++ == '}') return curr; // end of the accessor
+
+        ASSERT(*curr != '\0' && "parsing accessors failed probably you forget to close brackets!");
+        if (*curr == '\0') return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+        curr++;
+        switch (FindKeyword(AAccessorTable, curr))
+        {
+            case AAccessorTable.Index("bufferView"):    accessor.bufferView = ParsePositiveNumber(curr); accessor.hasBufferView = 1; break;
+            case AAccessorTable.Index("byteOffset"):    accessor.byteOffset = ParsePositiveNumber(curr); break;
+            case AAccessorTable.Index("componentType"): accessor.componentType = ParsePositiveNumber(curr) - 0x1400; break; // GL_BYTE 
+            case AAccessorTable.Index("count"):         accessor.count = ParsePositiveNumber(curr); break;
+            case AAccessorTable.Index("name"):
+            {
+                curr += sizeof("name'"); // we don't need accessor's name
+                int numQuotes = 0;
+                // skip two quotes
+                while (numQuotes < 2)
+                    numQuotes += *curr++ == '"';
+                break;
+            }
+            case AAccessorTable.Index("type"):
+            {
+                curr += sizeof("type'"); // skip type
+                curr = SkipUntill(curr, '"');
+                curr++;
+                
+                switch (FindKeyword(AAccessorTypeTable, curr))
+                {   case AAccessorTypeTable.Index("SCALAR"): accessor.type = 1; break;
+                    case AAccessorTypeTable.Index("VEC2"):   accessor.type = 2; break;
+                    case AAccessorTypeTable.Index("VEC3"):   accessor.type = 3; break;
+                    case AAccessorTypeTable.Index("VEC4"):   accessor.type = 4; break;
+                    case AAccessorTypeTable.Index("MAT4"):   accessor.type = 16;break;
+                    default: ASSERT(0 && "Unknown accessor type");
+                };
+                curr = SkipAfter(curr, '"');
+                break;
+            }
+            case AAccessorTable.Index("min"): 
+                curr = ParseAccessorBounds(curr, accessor.min); accessor.hasBounds |= 1;
+                if (curr < (const char*)AError_MAX) return curr;
+                break;
+            case AAccessorTable.Index("max"): 
+                curr = ParseAccessorBounds(curr, accessor.max); accessor.hasBounds |= 2;
+                if (curr < (const char*)AError_MAX) return curr;
+                break;
+            case AAccessorTable.Index("normalized"): curr = SkipAfter(curr, '"'); break;
+            case AAccessorTable.Index("sparse"):
+                accessor.sparse = curr;
+                curr = SkipToNextNode(curr, '{');
+                break;
+            default:
+                ASSERT(0 && "unknown accessor var");
+                return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+        }
+    }
+}
+
+struct AAccessorChunks
+{
+    const AArrayChunk* chunks;
+    const char** results; // end of each chunk or error
+    GLTFAccessor* accessors;
+};
+
+static void ParseAccessorChunk(int index, void* arg)
+{
+    AAccessorChunks* job = (AAccessorChunks*)arg;
+    const AArrayChunk& chunk = job->chunks[index];
+    const char* curr = chunk.begin;
+    for (int i = chunk.first; i < chunk.first + chunk.count && curr >= (const char*)AError_MAX; i++)
+    {
+        MemsetZero(&job->accessors[i], sizeof(GLTFAccessor));
+        curr = ParseAccessor(SkipUntill(curr, '{') + 1, job->accessors[i]);
+    }
+    job->results[index] = curr;
+}
+
+// numThreads > 1 splits big arrays between threads, output is same as serial parsing
+__private const char* ParseAccessors(const char* curr, Array<GLTFAccessor>& accessorArray, int numThreads)
+{
+    curr = SkipUntill(curr, '[');
+    AArrayChunk chunks[AMaxArrayChunks];
+    int numChunks = numThreads > 1 ? SplitArray(curr, numThreads, chunks) : 0;
+    if (numChunks > 1)
+    {
+        const char* results[AMaxArrayChunks];
+        const AArrayChunk& last = chunks[numChunks - 1];
+        accessorArray.AddUninitialized(last.first + last.count);
+
+        AAccessorChunks job = { chunks, results, accessorArray.Data() };
+        AParallelFor(numChunks, ParseAccessorChunk, &job, numThreads);
+
+        for (int i = 0; i < numChunks; i++)
+            if (results[i] < (const char*)AError_MAX) return results[i];
+        return SkipAfter(results[numChunks - 1], ']');
+    }
+
+    curr++; // skip [
+    // read each accessor
+    while (*(curr = NextStructural(curr)) != ']')
+    {
+        ASSERT(*curr == '{' && "parsing accessors failed probably you forget to close brackets!");
+        if (*curr != '{') return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+        GLTFAccessor accessor{};
+        curr = ParseAccessor(curr + 1, accessor);
+        if (curr < (const char*)AError_MAX) return curr;
+        accessorArray.Add(accessor);
+    }
+    return ++curr; // end all accessors
+}
+
+struct GLTFSparse
+{
+    int count;
+    int indexView, indexOffset, indexType;
+    int valueView, valueOffset;
+};
+
+static constexpr const char* ASparseKeys[] = { "count", "indices", "values", "bufferView", "byteOffset", "componentType" };
+static constexpr AKeywordTable<ArraySize(ASparseKeys)> ASparseTable(ASparseKeys);
+
+// curr is the accessor's sparse pointer. returns pointer after the sparse object or error
+__private const char* ParseSparse(const char* curr, GLTFSparse& sparse)
+{
+    sparse = GLTFSparse{};
+    curr = SkipAfter(curr, '{');
+    int depth = 1;
+    int* object = nullptr; // indices or values object that we are in, buffer view and offset are next to each other
+    while (depth > 0)
+    {
+        curr = NextStructural(curr);
+        if (*curr == '\0') return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+        if (*curr != '"') 
+        {
+            depth += *curr == '{';
+            if (*curr == '}' && --depth == 1) object = nullptr;
+            curr++;
+            continue;
+        }
+        curr++;
+        switch (FindKeyword(ASparseTable, curr))
+        {
+            case ASparseTable.Index("count"):   sparse.count = ParsePositiveNumber(curr); break;
+            case ASparseTable.Index("indices"): object = &sparse.indexView; curr = SkipAfter(curr, '"'); break;
+            case ASparseTable.Index("values"):  object = &sparse.valueView; curr = SkipAfter(curr, '"'); break;
+            case ASparseTable.Index("bufferView"):    if (!object) return (const char*)AError_UNKNOWN_ACCESSOR_VAR; object[0] = ParsePositiveNumber(curr); break;
+            case ASparseTable.Index("byteOffset"):    if (!object) return (const char*)AError_UNKNOWN_ACCESSOR_VAR; object[1] = ParsePositiveNumber(curr); break;
+            case ASparseTable.Index("componentType"): sparse.indexType = ParsePositiveNumber(curr) - 0x1400; break;
+            default:
+                ASSERT(0 && "unknown sparse accessor var");
+                return (const char*)AError_UNKNOWN_ACCESSOR_VAR;
+        }
+    }
+    return curr;
+}
+
+// used when position accessor doesn't have min and max. stride is 12 for tightly packed positions
+__private void PositionBounds(const char* positions, int count, int stride, float* outMin, float* outMax)
+{
+    float mn[3] = { 3.402823466e+38f, 3.402823466e+38f, 3.402823466e+38f };
+    float mx[3] = { -3.402823466e+38f, -3.402823466e+38f, -3.402823466e+38f };
+    int i = 0;
+#if defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+    if (stride == 12)
+    {
+        // 4 positions are 3 vectors: xyzx yzxy zxyz, each register keeps its own components
+        __m128 min0 = _mm_set1_ps(mn[0]), min1 = min0, min2 = min0;
+        __m128 max0 = _mm_set1_ps(mx[0]), max1 = max0, max2 = max0;
+        const float* f = (const float*)positions;
+        for (; i + 4 <= count; i += 4, f += 12)
+        {
+            __m128 a = _mm_loadu_ps(f), b = _mm_loadu_ps(f + 4), c = _mm_loadu_ps(f + 8);
+            min0 = _mm_min_ps(min0, a); max0 = _mm_max_ps(max0, a);
+            min1 = _mm_min_ps(min1, b); max1 = _mm_max_ps(max1, b);
+            min2 = _mm_min_ps(min2, c); max2 = _mm_max_ps(max2, c);
+        }
+        alignas(16) float lo[12], hi[12];
+        _mm_store_ps(lo, min0); _mm_store_ps(lo + 4, min1); _mm_store_ps(lo + 8, min2);
+        _mm_store_ps(hi, max0); _mm_store_ps(hi + 4, max1); _mm_store_ps(hi + 8, max2);
+        for (int j = 0; j < 12; j++)
+        {
+            mn[j % 3] = MIN(mn[j % 3], lo[j]);
+            mx[j % 3] = MAX(mx[j % 3], hi[j]);
+        }
+    }
+    else if (stride >= 16)
+    {
+        // 16 byte load reads 4 bytes after the position, which is still in the stride, except for the last one.
+        // last position and smaller strides are handled by the scalar loop below
+        __m128 vmin = _mm_set1_ps(mn[0]), vmax = _mm_set1_ps(mx[0]);
+        for (; i + 1 < count; i++)
+        {
+            __m128 v = _mm_loadu_ps((const float*)(positions + (int64_t)i * stride));
+            vmin = _mm_min_ps(vmin, v);
+            vmax = _mm_max_ps(vmax, v);
+        }
+        alignas(16) float lo[4], hi[4];
+        _mm_store_ps(lo, vmin); _mm_store_ps(hi, vmax);
+        for (int j = 0; j < 3; j++) mn[j] = lo[j], mx[j] = hi[j];
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float* p = (const float*)(positions + (int64_t)i * stride);
+        for (int j = 0; j < 3; j++)
+        {
+            mn[j] = MIN(mn[j], p[j]);
+            mx[j] = MAX(mx[j], p[j]);
+        }
+    }
+    for (int j = 0; j < 3; j++) outMin[j] = mn[j], outMax[j] = mx[j];
+}
+
+static constexpr const char* ABufferViewKeys[] = { "buffer", "byteOffset", "byteLength", "byteStride", "target", "name" };
+static constexpr AKeywordTable<ArraySize(ABufferViewKeys)> ABufferViewTable(ABufferViewKeys);
+
+__private const char* ParseBufferViews(const char* curr, Array<GLTFBufferView>& bufferViews)
+{
+    GLTFBufferView bufferView{};
+    curr += sizeof("bufferViews'");
+
+    // read each buffer view
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}') // next buffer view
+            {
+                bufferViews.Add(bufferView);
+                MemsetZero(&bufferView, sizeof(GLTFBufferView));
+            }
+            if (*curr++ == ']') return curr; // end all buffer views
+        }
+        ASSERT(*curr != '0' && "buffer view parse failed, probably you forgot to close brackets!");
+        curr++;
+
+        switch (FindKeyword(ABufferViewTable, curr))
+        {
+            case ABufferViewTable.Index("buffer"):     bufferView.buffer = ParsePositiveNumber(curr); break; 
+            case ABufferViewTable.Index("byteOffset"): bufferView.byteOffset = ParsePositiveNumber(curr); break; 
+            case ABufferViewTable.Index("byteLength"): bufferView.byteLength = ParsePositiveNumber(curr); break; 
+            case ABufferViewTable.Index("byteStride"): bufferView.byteStride = ParsePositiveNumber(curr); break; 
+            case ABufferViewTable.Index("target"):     bufferView.target = ParsePositiveNumber(curr); break;
+            case ABufferViewTable.Index("name"):  {
+                curr = SkipAfter(curr, '"'); // skip key
+                int numQuote = 0;
+                while (numQuote < 2)
+                    numQuote += *curr++ == '"';
+                break;
+            }
+            default: {
+                ASSERT(0 && "UNKNOWN buffer view value!");
+                return (const char*)AError_UNKNOWN_BUFFER_VIEW_VAR;
+            }
+        };
+    }
+}
+
+// number of bytes after decoding, '=' padding is not counted
+inline uint64_t Base64DecodedSize(const char* src, uint64_t srcLength)
+{
+    while (srcLength > 0 && src[srcLength - 1] == '=') srcLength--;
+    uint64_t remainder = srcLength & 3;
+    return (srcLength >> 2) * 3 + (remainder > 1 ? remainder - 1 : 0);
+}
+
+#if defined(AX_SUPPORT_AVX2)
+// Wojciech Mula, Daniel Lemire: Faster Base64 Encoding and Decoding using AVX2 Instructions
+// decodes 32 characters to 24 bytes, returns false if there is a non base64 character
+inline bool DecodeBase64AVX2(char* dst, const char* src)
+{
+    const __m256i lutLo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+
+    __m256i input     = _mm256_loadu_si256((const __m256i*)src);
+    __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), mask2F);
+    __m256i loNibbles = _mm256_and_si256(input, mask2F);
+    __m256i lo        = _mm256_shuffle_epi8(lutLo, loNibbles);
+    __m256i hi        = _mm256_shuffle_epi8(lutHi, hiNibbles);
+    if (!_mm256_testz_si256(lo, hi)) return false;
+
+    // '/' and '+' has same high nibble, we are using cmpeq for seperating them
+    __m256i eq2F   = _mm256_cmpeq_epi8(input, mask2F);
+    __m256i roll   = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+    __m256i values = _mm256_add_epi8(input, roll);
+
+    // pack 4x6 bits to 3 bytes
+    __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    packed = _mm256_shuffle_epi8(packed, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+    
+    // store exactly 24 bytes, dst is allocated with decoded size
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(packed));
+    _mm_storel_epi64((__m128i*)(dst + 16), _mm256_extracti128_si256(packed, 1));
+    return true;
+}
+#elif defined(AX_ARM) && defined(__aarch64__)
+// maps ascii characters to 6 bit values, invalid is set to 0xFF for the characters that are not base64
+inline uint8x16_t Base64LookupNeon(uint8x16_t v, uint8x16_t* invalid)
+{
+    uint8x16_t upper = vcltq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8(26));
+    uint8x16_t lower = vcltq_u8(vsubq_u8(v, vdupq_n_u8('a')), vdupq_n_u8(26));
+    uint8x16_t digit = vcltq_u8(vsubq_u8(v, vdupq_n_u8('0')), vdupq_n_u8(10));
+    uint8x16_t plus  = vceqq_u8(v, vdupq_n_u8('+'));
+    uint8x16_t slash = vceqq_u8(v, vdupq_n_u8('/'));
+
+    uint8x16_t result = vandq_u8(upper, vsubq_u8(v, vdupq_n_u8('A')));
+    result = vbslq_u8(lower, vsubq_u8(v, vdupq_n_u8('a' - 26)), result);
+    result = vbslq_u8(digit, vaddq_u8(v, vdupq_n_u8(52 - '0')), result);
+    result = vbslq_u8(plus,  vdupq_n_u8(62), result);
+    result = vbslq_u8(slash, vdupq_n_u8(63), result);
+    
+    uint8x16_t valid = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(plus, slash)));
+    *invalid = vorrq_u8(*invalid, vmvnq_u8(valid));
+    return result;
+}
+
+// decodes 64 characters to 48 bytes, returns false if there is a non base64 character
+inline bool DecodeBase64Neon(char* dst, const char* src)
+{
+    uint8x16x4_t input = vld4q_u8((const uint8_t*)src); // deinterleaved, val[0] is first char of each group
+    uint8x16_t invalid = vdupq_n_u8(0);
+    uint8x16_t a = Base64LookupNeon(input.val[0], &invalid);
+    uint8x16_t b = Base64LookupNeon(input.val[1], &invalid);
+    uint8x16_t c = Base64LookupNeon(input.val[2], &invalid);
+    uint8x16_t d = Base64LookupNeon(input.val[3], &invalid);
+    if (vmaxvq_u8(invalid) != 0) return false;
+    
+    uint8x16x3_t output;
+    output.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+    output.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+    output.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+    vst3q_u8((uint8_t*)dst, output);
+    return true;
+}
+#endif
+
+// dst should be at least Base64DecodedSize bytes, '=' padding at the end is allowed
+static void DecodeBase64(char *dst, const char *src, size_t src_length)
+{
+    struct Base64Table
+    {
+        uint8_t table[256] = { 0 };
+        constexpr Base64Table()
+        {
+            for (char c = 'A'; c <= 'Z'; c++) table[c] = (uint8_t)(c - 'A');
+            for (char c = 'a'; c <= 'z'; c++) table[c] = (uint8_t)(26 + (c - 'a'));
+            for (char c = '0'; c <= '9'; c++) table[c] = (uint8_t)(52 + (c - '0'));
+            table['+'] = 62;
+            table['/'] = 63;
+        }
+    };
+    
+    static constexpr Base64Table table{};
+    
+    while (src_length > 0 && src[src_length - 1] == '=') src_length--;
+    uint64_t i = 0;
+
+#if defined(AX_SUPPORT_AVX2)
+    for (; i + 32 <= src_length; i += 32, dst += 24)
+        if (!DecodeBase64AVX2(dst, src + i)) break; // invalid characters are decoded as zero by the scalar code
+#elif defined(AX_ARM) && defined(__aarch64__)
+    for (; i + 64 <= src_length; i += 64, dst += 48)
+        if (!DecodeBase64Neon(dst, src + i)) break;
+#endif
+
+    for (; i + 4 <= src_length; i += 4) {
+        uint32_t a = table.table[(uint8_t)src[i + 0]];
+        uint32_t b = table.table[(uint8_t)src[i + 1]];
+        uint32_t c = table.table[(uint8_t)src[i + 2]];
+        uint32_t d = table.table[(uint8_t)src[i + 3]];
+           
+        dst[0] = (char)(a << 2 | b >> 4);
+        dst[1] = (char)(b << 4 | c >> 2);
+        dst[2] = (char)(c << 6 | d);
+        dst += 3;
+    }
+
+    // last group that has padding, 2 characters is 1 byte, 3 characters is 2 bytes
+    uint64_t remainder = src_length - i;
+    if (remainder > 1)
+    {
+        uint32_t a = table.table[(uint8_t)src[i + 0]];
+        uint32_t b = table.table[(uint8_t)src[i + 1]];
+        dst[0] = (char)(a << 2 | b >> 4);
+        if (remainder == 3) 
+            dst[1] = (char)(b << 4 | table.table[(uint8_t)src[i + 2]] >> 2);
+    }
+}
+
+// .bin file that will be read by the io thread, see ALoadFlags_AsyncBuffers
+struct ABufferRead
+{
+    int  buffer; // index of the buffer
+    char path[256];
+    uint64_t size; // size of the file, filled by the io thread
+};
+
+struct ABufferReadQueue
+{
+    Array<ABufferRead> reads;
+    GLTFBuffer* buffers;
+    AThread thread;
+    bool running;
+};
+
+static void ReadBuffersThread(void* arg)
+{
+    ABufferReadQueue* queue = (ABufferReadQueue*)arg;
+    for (int i = 0; i < queue->reads.Size(); i++)
+    {
+        ABufferRead& read = queue->reads[i];
+        queue->buffers[read.buffer].uri = ReadAllFile(read.path, nullptr, &read.size);
+    }
+}
+
+// starts reading all of the .bin files in background, parsing can continue in the mean time
+__private void StartBufferReads(ABufferReadQueue& queue, Array<GLTFBuffer>& buffers)
+{
+    queue.buffers = buffers.Data();
+    queue.running = queue.reads.Size() > 0 && AThreadCreate(&queue.thread, ReadBuffersThread, &queue);
+    // couldn't create the thread, read synchronously
+    if (!queue.running) ReadBuffersThread(&queue);
+}
+
+// waits until all of the buffers are read, 
+// returns AError_BIN_NOT_EXIST if any of the files are not exist, AError_BUFFER_PARSE_FAIL if file is shorter than byteLength
+__private AErrorType WaitBufferReads(ABufferReadQueue& queue)
+{
+    if (queue.running) AThreadJoin(queue.thread);
+    queue.running = false;
+    if (queue.buffers == nullptr) // reads are never started
+        return queue.reads.Size() == 0 ? AError_NONE : AError_BIN_NOT_EXIST;
+
+    for (int i = 0; i < queue.reads.Size(); i++)
+    {
+        const GLTFBuffer& buffer = queue.buffers[queue.reads[i].buffer];
+        if (buffer.uri == nullptr)
+            return AError_BIN_NOT_EXIST;
+        if ((uint64_t)buffer.byteLength > queue.reads[i].size)
+            return AError_BUFFER_PARSE_FAIL;
+    }
+    return AError_NONE;
+}
+
+// binChunk is the BIN chunk of .glb file, buffer that has no uri uses it, null for .gltf files. binChunkSize is it's length
+// if readQueue is not null .bin files are not read here, paths are pushed to the queue instead
+// if resolver is not null, uris are resolved with it and path can be null, if both are null external uris fail
+// keepMask can be null, otherwise buffers that are not in the mask are not read and their uri is null
+static constexpr const char* ABufferKeys[] = { "uri", "byteLength", "name" };
+static constexpr AKeywordTable<ArraySize(ABufferKeys)> ABufferTable(ABufferKeys);
+
+__private const char* ParseBuffers(const char* curr, const char* path, Array<GLTFBuffer>& bufferArray, 
+                                   const char* binChunk, uint64_t binChunkSize, ALoadFlags flags, ABufferReadQueue* readQueue,
+                                   AUriResolver resolver, void* userData, const Array<uint8_t>* keepMask)
+{
+    GLTFBuffer buffer{};
+    bool hasUri = false;
+    uint64_t resolvedSize = ~0ull; // size of the resolved, read or mapped data, byteLength can't exceed it
+    curr += sizeof("buffers'"); // skip buffers"
+    char binFilePath[256]={0};
+    char* endOfWorkDir = binFilePath;
+    int binPathlen = path ? StringLength(path) : 0;
+    SmallMemCpy(binFilePath, path, binPathlen);
+    endOfWorkDir = binFilePath + binPathlen;
+    
+    // remove bla.gltf
+    while (binPathlen > 0 && binFilePath[binPathlen - 1] != '/' && binFilePath[binPathlen - 1] != '\\')
+        binFilePath[--binPathlen] = '\0', endOfWorkDir--;
+
+    // read each buffer
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}') // next buffer
+            {
+                if (!hasUri && binChunk != nullptr)
+                {
+                    // glb buffer, point directly into the file instead of copying
+                    buffer.uri = (void*)binChunk;
+                    buffer.flags = ABufferFlag_GLB;
+                    resolvedSize = binChunkSize;
+                    binChunk = nullptr; // only first buffer can refer to BIN chunk
+                }
+                if ((uint64_t)buffer.byteLength > resolvedSize)
+                {
+                    ASSERT(0 && "buffer byteLength is bigger than resolved data");
+                    if (buffer.flags == ABufferFlag_None) AX_FREE(buffer.uri);
+                    if (buffer.flags == ABufferFlag_Mapped) AUnmapFile(buffer.uri, buffer.mappedSize);
+                    return (const char*)AError_BUFFER_PARSE_FAIL;
+                }
+                bufferArray.Add(buffer);
+                MemsetZero(&buffer, sizeof(GLTFBuffer));
+                hasUri = false;
+                resolvedSize = ~0ull;
+                MemsetZero(endOfWorkDir, sizeof(binFilePath) - (size_t)(endOfWorkDir - binFilePath));
+            }
+
+            if (*curr++ == ']') return curr; // end all buffers
+        }
+        ASSERT(*curr && "parsing buffers failed, probably you forgot to close braces");
+        curr++;
+        int key = FindKeyword(ABufferTable, curr);
+        if (key == ABufferTable.Index("uri"))
+        {
+            hasUri = true;
+            curr += sizeof("uri'"); // skip uri": 
+            while (*curr != '"') curr++;
+            if (keepMask && !IsSelected(*keepMask, bufferArray.Size()))
+            {
+                curr = SkipAfter(curr + 1, '"'); // none of the needed accessors use this buffer
+            }
+            else if (StartsWith(curr, "\"data:"))
+            {
+                curr = SkipAfter(curr, ',');
+                uint64_t base64Size = 0;
+                while (curr[base64Size] != '\"') {
+                    base64Size++;
+                }
+                resolvedSize = Base64DecodedSize(curr, base64Size);
+                buffer.uri = AX_MALLOC(resolvedSize);
+                DecodeBase64((char*)buffer.uri, curr, base64Size);
+                curr += base64Size + 1;
+            }
+            else
+            {
+                curr = GetStringInQuotes(endOfWorkDir, curr);
+                if (resolver != nullptr)
+                {
+                    AResolvedData resolved{};
+                    if (!resolver(endOfWorkDir, &resolved, userData)) return (const char*)AError_BIN_NOT_EXIST;
+                    buffer.uri   = resolved.data;
+                    buffer.flags = resolved.owned ? ABufferFlag_None : ABufferFlag_External;
+                    resolvedSize = resolved.size;
+                    continue;
+                }
+                else if (path == nullptr)
+                {
+                    // parsing from memory without resolver, there is no directory to search the .bin
+                    return (const char*)AError_BIN_NOT_EXIST;
+                }
+                else if (readQueue != nullptr)
+                {
+                    // uri will be filled by the io thread
+                    ABufferRead read;
+                    read.buffer = bufferArray.Size();
+                    read.size   = 0;
+                    SmallMemCpy(read.path, binFilePath, sizeof(binFilePath));
+                    readQueue->reads.Add(read);
+                    continue;
+                }
+                else if (flags & ALoadFlags_MapBuffers)
+                {
+                    uint64_t mappedSize = 0;
+                    buffer.uri = AMapFile(binFilePath, &mappedSize);
+                    buffer.mappedSize = mappedSize;
+                    buffer.flags = ABufferFlag_Mapped;
+                    resolvedSize = mappedSize;
+                }
+                else
+                    buffer.uri = ReadAllFile(binFilePath, nullptr, &resolvedSize);
+                ASSERT(buffer.uri && "uri is not exist");
+                if (!buffer.uri) return (const char*)AError_BIN_NOT_EXIST;
+            }
+        }
+        else if (key == ABufferTable.Index("byteLength"))
+        {
+            buffer.byteLength = ParsePositiveNumber(++curr);
+        }
+        else if (key == ABufferTable.Index("name"))
+        {
+            curr = SkipAfter(curr, '"'); // skip key
+            curr = SkipAfter(curr, '"'); 
+            curr = SkipAfter(curr, '"'); // skip value
+        }
+        else
+        {
+            ASSERT(0 && "Unknown buffer variable! byteLength or uri excepted.");
+            return (const char*)AError_BUFFER_PARSE_FAIL;
+        }
+    }
+}
+
+// write paths to path buffer, buffer is seperated by null terminators
+__private const char* ParseImages(const char* curr, const char* path, Array<AImage>& images, AStringAllocator& stringAllocator,
+                                  AUriResolver resolver, void* userData)
+{
+    curr = SkipUntill(curr, '[');
+    curr++;
+    
+    int pathLen = path ? StringLength(path) : 0;
+    while (pathLen > 0 && path[pathLen-1] != '/') pathLen--;
+
+    AImage image{};
+    // read each buffer
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+            if (*curr++ == ']')
+                return curr; // end all images
+        
+        ASSERT(*curr != '\0' && "parse images failed probably you forgot to close brackets");
+
+        curr++;
+        bool isUri = StrCMP16(curr, "uri");
+
+        // mimeType and name is not supported
+        if (isUri)
+        {
+            curr += 4;
+            curr = SkipAfter(curr, '"');
+            int uriSize = 0;
+            while (curr[uriSize] != '"') uriSize++;
+
+            image.path = stringAllocator.Allocate(uriSize + pathLen + 16);
+            SmallMemCpy(image.path, path, pathLen);
+            SmallMemCpy(image.path + pathLen, curr, uriSize);
+            image.path[uriSize + pathLen] = '\0';
+            const char* uri = curr;
+            bool isDataUri = StartsWith(uri, "data:"); // embedded images are not resolved, user decodes the path
+            curr += uriSize;
+
+            // images are optional, if resolver can't find it user can still use the path
+            AResolvedData resolved{};
+            if (resolver && !isDataUri && resolver(image.path, &resolved, userData))
+            {
+                image.data     = resolved.data;
+                image.dataSize = resolved.size;
+                image.ownsData = resolved.owned;
+            }
+            images.PushBack(image);
+        }
+    }
+    return nullptr;
+}
+
+static constexpr const char* ATextureKeys[] = { "sampler", "source", "name" };
+static constexpr AKeywordTable<ArraySize(ATextureKeys)> ATextureTable(ATextureKeys);
+
+__private const char* ParseTextures(const char* curr, Array<ATexture>& textures, AStringAllocator& stringAllocator)
+{
+    curr += sizeof("textures'");
+    ATexture texture{};
+
+    // read each buffer
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}') // next buffer view
+            {
+                textures.Add(texture);
+                MemsetZero(&texture, sizeof(ATexture));
+            }
+
+            if (*curr == ']') // end all buffer views
+            return ++curr;
+            curr++;
+        }
+        ASSERT(*curr != '\0' && "parse images failed probably you forgot to close brackets");
+        curr++;
+        switch (FindKeyword(ATextureTable, curr))
+        {
+            case ATextureTable.Index("sampler"): texture.sampler = ParsePositiveNumber(++curr); break;
+            case ATextureTable.Index("source"):  texture.source = ParsePositiveNumber(++curr); break;
+            case ATextureTable.Index("name"):    curr = CopyStringInQuotes(texture.name, curr + 5, stringAllocator); break;
+            default:
+                ASSERT(0 && "Unknown buffer variable! sampler, source or name excepted.");
+                return (const char*)AError_UNKNOWN_TEXTURE_VAR;
+        }
+    }
+}
+
+// same order as AAttribType bits
+static constexpr const char* AAttributeKeys[] = { "POSITION", "TEXCOORD_0", "NORMAL", "TANGENT", "TEXCOORD_1", "JOINTS_0", "WEIGHTS_0" };
+static constexpr AKeywordTable<ArraySize(AAttributeKeys)> AAttributeTable(AAttributeKeys);
+static_assert(ArraySize(AAttributeKeys) == AAttribType_Count, "attribute keys must match AAttribType");
+
+__private const char* ParseAttributes(const char* curr, APrimitive* primitive)
+{
+    curr += sizeof("attributes'");
+
+    while (true)
+    {
+        while (*(curr = NextStructural(curr)) != '"')
+        if (*curr++ == '}') return curr;
+        
+        curr++; // skip "
+        unsigned maskBefore = primitive->attributes;
+        int attribute = FindKeyword(AAttributeTable, curr);
+        if (attribute >= 0) 
+        {   // keys are in the same order as attribute bits
+            primitive->attributes |= 1u << attribute; 
+        }
+        else if (StrCMP16(curr, "TEXCOORD_"))  { curr = SkipAfter(curr, '"'); continue; } // < NO more than two texture coords
+        else { ASSERT(0 && "attribute variable unknown!"); return (const char*)AError_UNKNOWN_ATTRIB; }
 
         curr = SkipUntill(curr, '"'); curr++;// skip quote because attribute in double quotes
         // using bitmask will help us to order attributes correctly(sort) Position, Normal, TexCoord
@@ -2706,945 +4104,3911 @@ __private const char* ParseAttributes(const char* curr, APrimitive* primitive)
     }
 }
 
-__private const char* ParseMeshes(const char* curr, Array<AMesh>& meshes, AStringAllocator& stringAllocator)
+static constexpr const char* AMeshKeys[]      = { "name", "primitives" };
+static constexpr const char* APrimitiveKeys[] = { "attributes", "indices", "mode", "material" };
+static constexpr AKeywordTable<ArraySize(AMeshKeys)>      AMeshTable(AMeshKeys);
+static constexpr AKeywordTable<ArraySize(APrimitiveKeys)> APrimitiveTable(APrimitiveKeys);
+
+// keepMask can be null, otherwise meshes that are not in the mask are skipped and added as empty mesh
+// primitiveCounts can be null, otherwise primitives of each mesh are allocated with that size
+__private const char* ParseMeshes(const char* curr, Array<AMesh>& meshes, AStringAllocator& stringAllocator, 
+                                  const Array<uint8_t>* keepMask, const Array<int>* primitiveCounts)
+{
+    curr += sizeof("meshes'"); // skip meshes" 
+    AMesh mesh{};
+    MemsetZero(&mesh, sizeof(AMesh));
+
+    // parse all meshes
+    while (true)
+    {
+        while (*(curr = NextStructural(curr)) != '"')
+        {
+            if (*curr == '{' && keepMask && !IsSelected(*keepMask, meshes.Size()))
+            {
+                curr = SkipToNextNode(curr, '{');
+                meshes.Add(mesh); // empty, so node indices stay valid
+                continue;
+            }
+            if (*curr == '}') 
+            {
+                meshes.Add(mesh);
+                MemsetZero(&mesh, sizeof(AMesh));
+            }
+            if (*curr++ == ']') return curr; // end of meshes
+        }
+        int key = FindKeyword(AMeshTable, ++curr);
+        curr = SkipAfter(curr, '"');
+        
+        if (key == AMeshTable.Index("name")) {
+            curr = CopyStringInQuotes(mesh.name, curr, stringAllocator); 
+            continue; 
+        }
+        else if (key != AMeshTable.Index("primitives")) { 
+            ASSERT(0 && "only primitives and name allowed"); 
+            return (const char*)AError_UNKNOWN_MESH_VAR; 
+        }
+
+        if (primitiveCounts && meshes.Size() < primitiveCounts->Size() && (*primitiveCounts)[meshes.Size()] > 0)
+            SBReserve(mesh.primitives, (*primitiveCounts)[meshes.Size()]);
+
+        APrimitive primitive{};  
+        primitive.material = -1;
+        primitive.mode = 4; // triangles if mode is not written
+        // parse primitives
+        while (true)
+        {
+            while (*(curr = NextStructural(curr)) != '"')
+            {
+                if (*curr == '}')
+                {
+                    SBPush(mesh.primitives, primitive);
+                    MemsetZero(&primitive, sizeof(APrimitive));
+                    mesh.numPrimitives++;
+                    primitive.material = -1;
+                    primitive.mode = 4;
+                }
+
+                if (*curr++ == ']') goto end_primitives; // this is end of primitive list
+            }
+            curr++;
+            
+            switch (FindKeyword(APrimitiveTable, curr))
+            {
+                case APrimitiveTable.Index("attributes"): curr = ParseAttributes(curr, &primitive); break;
+                case APrimitiveTable.Index("indices"):    primitive.indiceIndex = ParsePositiveNumber(curr); break;
+                case APrimitiveTable.Index("mode"):       primitive.mode        = ParsePositiveNumber(curr); break;
+                case APrimitiveTable.Index("material"):   primitive.material    = ParsePositiveNumber(curr); break;
+                default: ASSERT(0); return (const char*)AError_UNKNOWN_MESH_PRIMITIVE_VAR;
+            }
+        }
+        end_primitives:{} // ] is already skipped, next char might be } of mesh
+    }
+    return nullptr;
+}
+
+struct IntPtrPair { int numElements, *ptr; };
+
+static IntPtrPair ParseIntArray(const char*& cr, AIntAllocator& intAllocator)
+{
+    const char* curr = cr;
+    IntPtrPair result={};
+    // find how many elements there are:
+    while (!IsNumber(*curr)) curr++;
+    
+    const char* begin = curr;
+    result.numElements = 1;
+    while (true)
+    {
+        result.numElements += *curr == ',';
+        if (*curr++ == ']') break;
+    }
+    curr = begin;
+    result.ptr = intAllocator.AllocateUninitialized(result.numElements);
+    result.numElements = 0;
+    
+    while (*curr != ']')
+    {
+        if (IsNumber(*curr))
+        {
+            result.ptr[result.numElements] = ParsePositiveNumber(curr);
+            result.numElements++;
+        }
+        else curr++; // number might end with ] in minified json, don't skip it
+    }
+    cr = curr;
+    return result;
+}
+
+static constexpr const char* ANodeKeys[] = { 
+    "mesh", "camera", "children", "matrix", "translation", "rotation", "scale", "name", "skin" 
+};
+static constexpr AKeywordTable<ArraySize(ANodeKeys)> ANodeTable(ANodeKeys);
+
+__private void ResetNode(ANode& node, float scale)
+{
+    MemsetZero(&node, sizeof(ANode));
+    node.rotation[3] = 1.0f;
+    node.scale[0] = node.scale[1] = node.scale[2] = scale; 
+    node.index = -1;
+}
+
+// parses members of one node, curr must be after the '{', returns pointer after the closing '}'
+__private const char* ParseNode(const char* curr, ANode& node, AStringAllocator& stringAllocator, 
+                                AIntAllocator& intAllocator, float scale)
+{
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+            if (*curr++ == '}') return curr; // end of the node
+
+        ASSERT(*curr != '\0' && "parsing nodes not possible, probably forgot to close brackets!");
+        if (*curr == '\0') return (const char*)AError_UNKNOWN_NODE_VAR;
+        curr++; // skips the "
+        
+        switch (FindKeyword(ANodeTable, curr))
+        {
+            case ANodeTable.Index("mesh"):   node.type = 0; node.index = ParsePositiveNumber(curr); continue; // don't want to skip ] that's why continue
+            case ANodeTable.Index("camera"): node.type = 1; node.index = ParsePositiveNumber(curr); continue; // don't want to skip ] that's why continue
+            case ANodeTable.Index("children"):
+            {
+                IntPtrPair result = ParseIntArray(curr, intAllocator);
+                node.numChildren = result.numElements;
+                node.children = result.ptr;
+                break;
+            }
+            case ANodeTable.Index("matrix"):
+            {
+                Matrix4 m;
+                float* matrix = (float*)&m;
+                
+                for (int i = 0; i < 16; i++)
+                    matrix[i] = ParseFloat(curr);
+                
+                m = Matrix4::Transpose(m);
+                node.translation[0] = matrix[12];
+                node.translation[1] = matrix[13];
+                node.translation[2] = matrix[14];
+                QuaternionFromMatrix(node.rotation, matrix);
+
+                vec_t v = VecMulf(Matrix4::ExtractScaleV(m), scale);
+                Vec3Store(node.scale, v);
+                break;
+            }
+            case ANodeTable.Index("translation"):
+                node.translation[0] = ParseFloat(curr);
+                node.translation[1] = ParseFloat(curr);
+                node.translation[2] = ParseFloat(curr);
+                break;
+            case ANodeTable.Index("rotation"):
+                node.rotation[0] = ParseFloat(curr);
+                node.rotation[1] = ParseFloat(curr);
+                node.rotation[2] = ParseFloat(curr);
+                node.rotation[3] = ParseFloat(curr);
+                break;
+            case ANodeTable.Index("scale"):
+                node.scale[0] = ParseFloat(curr) * scale;
+                node.scale[1] = ParseFloat(curr) * scale;
+                node.scale[2] = ParseFloat(curr) * scale;
+                break;
+            case ANodeTable.Index("name"):
+                curr = CopyStringInQuotes(node.name, curr + 5, stringAllocator);
+                continue; 
+            case ANodeTable.Index("skin"):
+                node.skin = ParsePositiveNumber(curr);
+                continue; // continue because we don't want to skip ] and it is not exist
+            default:
+                ASSERT(0 && "Unknown node variable");
+                return (const char*)AError_UNKNOWN_NODE_VAR;
+        }
+
+        curr = SkipUntill(curr, ']');
+        curr++;
+    }
+}
+
+struct ANodeChunks
+{
+    const AArrayChunk* chunks;
+    const char** results; // end of each chunk or error
+    ANode* nodes;
+    AStringAllocator* stringAllocators; // one per chunk
+    AIntAllocator* intAllocators;
+    float scale;
+};
+
+static void ParseNodeChunk(int index, void* arg)
+{
+    ANodeChunks* job = (ANodeChunks*)arg;
+    const AArrayChunk& chunk = job->chunks[index];
+    const char* curr = chunk.begin;
+    for (int i = chunk.first; i < chunk.first + chunk.count && curr >= (const char*)AError_MAX; i++)
+    {
+        ResetNode(job->nodes[i], job->scale);
+        curr = ParseNode(SkipUntill(curr, '{') + 1, job->nodes[i], job->stringAllocators[index], job->intAllocators[index], job->scale);
+    }
+    job->results[index] = curr;
+}
+
+// numThreads > 1 splits big arrays between threads, output is same as serial parsing
+__private const char* ParseNodes(const char* curr,
+                                 Array<ANode>& nodes,
+                                 AStringAllocator& stringAllocator,
+                                 FixedSizeGrowableAllocator<int>& intAllocator, float scale, int numThreads)
+{
+    curr = SkipUntill(curr, '[');
+    AArrayChunk chunks[AMaxArrayChunks];
+    int numChunks = numThreads > 1 ? SplitArray(curr, numThreads, chunks) : 0;
+    if (numChunks > 1)
+    {
+        const char* results[AMaxArrayChunks];
+        AStringAllocator stringAllocators[AMaxArrayChunks];
+        AIntAllocator    intAllocators[AMaxArrayChunks];
+        const AArrayChunk& last = chunks[numChunks - 1];
+        nodes.AddUninitialized(last.first + last.count);
+
+        ANodeChunks job = { chunks, results, nodes.Data(), stringAllocators, intAllocators, scale };
+        AParallelFor(numChunks, ParseNodeChunk, &job, numThreads);
+
+        for (int i = 0; i < numChunks; i++)
+        {
+            stringAllocator.Append(stringAllocators[i]);
+            intAllocator.Append(intAllocators[i]);
+        }
+
+        for (int i = 0; i < numChunks; i++)
+            if (results[i] < (const char*)AError_MAX) return results[i];
+        return SkipAfter(results[numChunks - 1], ']');
+    }
+
+    curr++; // skip [
+    // read each node
+    while (*(curr = NextStructural(curr)) != ']')
+    {
+        ASSERT(*curr == '{' && "parsing nodes not possible, probably forgot to close brackets!");
+        if (*curr != '{') return (const char*)AError_UNKNOWN_NODE_VAR;
+        ANode node;
+        ResetNode(node, scale);
+        curr = ParseNode(curr + 1, node, stringAllocator, intAllocator, scale);
+        if (curr < (const char*)AError_MAX) return curr;
+        nodes.Add(node);
+    }
+    return ++curr; // end all nodes
+}
+
+static constexpr const char* ACameraKeys[]     = { "name", "type", "orthographic", "perspective" };
+static constexpr const char* AProjectionKeys[] = { "zfar", "znear", "aspectRatio", "yfov", "xmag", "ymag" };
+static constexpr AKeywordTable<ArraySize(ACameraKeys)>     ACameraTable(ACameraKeys);
+static constexpr AKeywordTable<ArraySize(AProjectionKeys)> AProjectionTable(AProjectionKeys);
+
+__private const char* ParseCameras(const char* curr, Array<ACamera>& cameras, AStringAllocator& stringAllocator)
+{
+    curr += sizeof("camera'");
+    ACamera camera{};
+    // parse all meshes
+    while (true)
+    {
+        while (*(curr = NextStructural(curr)) != '"')
+        {
+            if (*curr == '}') 
+            {
+                cameras.Add(camera);
+                MemsetZero(&camera, sizeof(ACamera));
+            }
+            if (*curr++ == ']') return curr; // end of cameras
+        }
+        int key = FindKeyword(ACameraTable, ++curr);
+        curr = SkipAfter(curr, '"');
+        
+        if (key == ACameraTable.Index("name")) {
+            curr = CopyStringInQuotes(camera.name, curr, stringAllocator); 
+            continue; 
+        }
+        if (key == ACameraTable.Index("type")) {
+            curr = SkipUntill(curr, '"');
+            curr++;
+            camera.type = *curr == 'p'; // 0 orthographic 1 perspective 
+            curr = SkipUntill(curr, '"');
+            curr++;
+            continue; 
+        }
+        else if (key != ACameraTable.Index("orthographic") && key != ACameraTable.Index("perspective")) { 
+            ASSERT(0 && "unknown camera variable"); 
+            return (const char*)AError_UNKNOWN_CAMERA_VAR; 
+        }
+
+        // parse primitives
+        while (true)
+        {
+            while (*(curr = NextStructural(curr)) != '"')
+            if (*curr++ == '}')  goto end_properties; // this is end of camera variables
+            
+            curr++;
+            switch (FindKeyword(AProjectionTable, curr))
+            {
+                case AProjectionTable.Index("zfar"):        camera.zFar        = ParseFloat(curr); break;
+                case AProjectionTable.Index("znear"):       camera.zNear       = ParseFloat(curr); break;
+                case AProjectionTable.Index("aspectRatio"): camera.aspectRatio = ParseFloat(curr); break;
+                case AProjectionTable.Index("yfov"):        camera.yFov        = ParseFloat(curr); break;
+                case AProjectionTable.Index("xmag"):        camera.xmag        = ParseFloat(curr); break;
+                case AProjectionTable.Index("ymag"):        camera.ymag        = ParseFloat(curr); break;
+                default: ASSERT(0); return (const char*)AError_UNKNOWN_CAMERA_VAR;
+            }
+        }
+        end_properties:{}
+    }
+    return nullptr;
+}
+
+static constexpr const char* ASceneKeys[] = { "nodes", "name" };
+static constexpr AKeywordTable<ArraySize(ASceneKeys)> ASceneTable(ASceneKeys);
+
+__private const char* ParseScenes(const char* curr, Array<AScene>& scenes, 
+                                  AStringAllocator& stringAllocator, FixedSizeGrowableAllocator<int>& intAllocator)
+{
+    curr = SkipUntill(curr, '[');
+    curr++;
+    AScene scene{};
+    // read each node
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}')
+            {
+                scenes.Add(scene);
+                MemsetZero(&scene, sizeof(AScene));
+            }
+            if (*curr++ == ']') return curr; // end all scenes
+        }
+        ASSERT(*curr != '\0' && "parsing scenes not possible, probably forgot to close brackets!");
+        curr++; // skips the "
+        int key = FindKeyword(ASceneTable, curr);
+        
+        if (key == ASceneTable.Index("nodes"))
+        {
+            // find how many childs there are:
+            while (!IsNumber(*curr)) curr++;
+            const char* begin = curr;
+            scene.numNodes = 1;
+            while (true)
+            {
+                scene.numNodes += *curr == ',';
+                if (*curr++ == ']') break;
+            }
+            curr = begin;
+            scene.nodes = intAllocator.AllocateUninitialized(scene.numNodes);
+            scene.numNodes = 0;
+
+            while (*curr != ']')
+            {
+                if (IsNumber(*curr))
+                {
+                    scene.nodes[scene.numNodes] = ParsePositiveNumber(curr);
+                    scene.numNodes++;
+                }
+                else curr++; // number might end with ] in minified json, don't skip it
+            }
+            curr++;// skip ]
+        }
+        else if (key == ASceneTable.Index("name"))
+        {
+            curr = CopyStringInQuotes(scene.name, curr + 5, stringAllocator);
+        }
+    } 
+}
+inline char OGLWrapToWrap(int wrap)
+{
+    switch (wrap)
+    {
+        case 0x2901: return 0; // GL_REPEAT          10497
+        case 0x812F: return 1; // GL_CLAMP_TO_EDGE   33071
+        case 0x812D: return 2; // GL_CLAMP_TO_BORDER 33069
+        case 0x8370: return 3; // GL_MIRRORED_REPEAT 33648
+        default: ASSERT(0 && "wrong or undefined sampler type!"); return 0;
+    }
+}
+
+static constexpr const char* ASamplerKeys[] = { "magFilter", "minFilter", "wrapS", "wrapT" };
+static constexpr AKeywordTable<ArraySize(ASamplerKeys)> ASamplerTable(ASamplerKeys);
+
+__private const char* ParseSamplers(const char* curr, Array<ASampler>& samplers)
+{
+    curr = SkipUntill(curr, '[');
+    curr++;
+    
+    ASampler sampler{};
+    
+    // read each node
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}')
+            {
+                samplers.Add(sampler);
+                MemsetZero(&sampler, sizeof(ASampler));
+            }
+            if (*curr++ == ']') return curr; // end all nodes
+        }
+        ASSERT(*curr != '\0' && "parsing nodes not possible, probably forgot to close brackets!");
+        curr++; // skips the "
+
+        switch (FindKeyword(ASamplerTable, curr))
+        {
+            case ASamplerTable.Index("magFilter"): sampler.magFilter = (char)(ParsePositiveNumber(curr) - 0x2600); break; // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
+            case ASamplerTable.Index("minFilter"): sampler.minFilter = (char)(ParsePositiveNumber(curr) - 0x2600); break; // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
+            case ASamplerTable.Index("wrapS"):     sampler.wrapS = (char)OGLWrapToWrap(ParsePositiveNumber(curr)); break;
+            case ASamplerTable.Index("wrapT"):     sampler.wrapT = (char)OGLWrapToWrap(ParsePositiveNumber(curr)); break;
+            default: ASSERT(0 && "parse samplers failed!"); return (const char*)AError_UNKNOWN;
+        }
+    }
+}
+
+static constexpr const char* AMaterialTextureKeys[] = { "scale", "index", "texCoord", "strength", "extensions" };
+static constexpr AKeywordTable<ArraySize(AMaterialTextureKeys)> AMaterialTextureTable(AMaterialTextureKeys);
+
+__private const char* ParseMaterialTexture(const char* curr, AMaterial::Texture& texture)
+{
+    curr = SkipUntill(curr, '{');
+    curr++;
+    while (true)
+    {
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr++ == '}') return curr;
+        }
+        ASSERT(*curr && "parsing material failed, probably forgot to close brackets");
+        curr++;
+
+        switch (FindKeyword(AMaterialTextureTable, curr))
+        {
+            case AMaterialTextureTable.Index("scale"):      curr = ParseFloat16(curr, texture.scale); break;
+            case AMaterialTextureTable.Index("index"):      texture.index = (char)ParsePositiveNumber(curr); break;
+            case AMaterialTextureTable.Index("texCoord"):   texture.texCoord = (char)ParsePositiveNumber(curr); break;
+            case AMaterialTextureTable.Index("strength"):   curr = ParseFloat16(curr, texture.strength); break;
+            case AMaterialTextureTable.Index("extensions"): curr = SkipToNextNode(curr, '{'); break; // currently extensions are not supported 
+            default:
+                ASSERT(0 && "unknown material texture value");
+                return (const char*)AError_UNKNOWN_MATERIAL_VAR;
+        }
+    }
+    return nullptr;
+}
+__forceinline uint32_t PackColorRGBAU32(float* c) {
+    return (uint32_t)(*c * 255.0f) | ((uint32_t)(c[1] * 255.0f) << 8) | ((uint32_t)(c[2] * 255.0f) << 16) | ((uint32_t)(c[3] * 255.0f) << 24);
+}
+
+static constexpr const char* AMaterialKeys[] = { 
+    "name", "doubleSided", "pbrMetallicRoughness", "normalTexture", "occlusionTexture", "emissiveTexture",
+    "emissiveFactor", "extensions", "alphaMode", "alphaCutoff"
+};
+static constexpr const char* APbrKeys[] = { 
+    "baseColorTexture", "metallicRoughnessTexture", "baseColorFactor", "metallicFactor", "roughnessFactor" 
+};
+static constexpr const char* AAlphaModeKeys[] = { "OPAQUE", "MASK", "BLEND" };
+static constexpr AKeywordTable<ArraySize(AMaterialKeys)>  AMaterialTable(AMaterialKeys);
+static constexpr AKeywordTable<ArraySize(APbrKeys)>       APbrTable(APbrKeys);
+static constexpr AKeywordTable<ArraySize(AAlphaModeKeys)> AAlphaModeTable(AAlphaModeKeys);
+
+// keepMask can be null, otherwise materials that are not in the mask are skipped and added as default material
+__private const char* ParseMaterials(const char* curr, Array<AMaterial>& materials, AStringAllocator& stringAllocator, const Array<uint8_t>* keepMask)
+{
+    // mesh, name, children, 
+    // matrix, translation, rotation, scale
+    curr = SkipUntill(curr, '[');
+    curr++; // skip '['
+    AMaterial material{};
+    // read each material
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '{' && keepMask && !IsSelected(*keepMask, materials.Size()))
+            {
+                curr = SkipToNextNode(curr, '{');
+                materials.Add(material);
+                continue;
+            }
+            if (*curr == '}')
+            {
+                materials.Add(material);
+                MemsetZero(&material, sizeof(AMaterial));
+                material.baseColorTexture.index = -1;
+            }
+            if (*curr++ == ']') return curr; // end all nodes
+        }
+        ASSERT(*curr && "parsing material failed, probably forgot to close brackets");
+
+        int texture = -1;
+        curr++; // skips the "
+        switch (FindKeyword(AMaterialTable, curr))
+        {
+            case AMaterialTable.Index("name"):
+                curr = CopyStringInQuotes(material.name, curr + 5, stringAllocator);
+                break;
+            case AMaterialTable.Index("doubleSided"):
+                curr += sizeof("doubleSided'"); // skip doubleSided"
+                AX_NO_UNROLL while (!IsLower(*curr)) curr++;
+                material.doubleSided = *curr == 't';
+                break;
+            case AMaterialTable.Index("pbrMetallicRoughness"):
+            {
+                curr = SkipUntill(curr, '{');
+    
+                // parse until finish
+                while (true)
+                {
+                    // search for name
+                    while (*(curr = NextStructural(curr)) && *curr != '"')
+                    {
+                        if (*curr++ == '}') { goto pbr_end; }
+                    }
+                    curr++; // skips the "
+                    
+                    switch (FindKeyword(APbrTable, curr))
+                    {
+                        case APbrTable.Index("baseColorTexture"):         curr = ParseMaterialTexture(curr, material.baseColorTexture); break;
+                        case APbrTable.Index("metallicRoughnessTexture"): curr = ParseMaterialTexture(curr, material.metallicRoughnessTexture); break;
+                        case APbrTable.Index("baseColorFactor"):
+                        {
+                            float baseColorFactor[4] = { ParseFloat(curr), ParseFloat(curr), ParseFloat(curr), ParseFloat(curr)};
+                            material.baseColorFactor = PackColorRGBAU32(baseColorFactor);
+                            curr = SkipUntill(curr, ']');
+                            curr++;
+                            break;
+                        }
+                        case APbrTable.Index("metallicFactor"):  curr = ParseFloat16(curr, material.metallicFactor); break;
+                        case APbrTable.Index("roughnessFactor"): curr = ParseFloat16(curr, material.roughnessFactor); break;
+                        default:
+                            ASSERT(0 && "unknown pbrMetallicRoughness value!");
+                            return (char*)AError_UNKNOWN_PBR_VAR;
+                    }
+                }
+                pbr_end: {}
+                break;
+            }
+            case AMaterialTable.Index("normalTexture"):    texture = 0; break;
+            case AMaterialTable.Index("occlusionTexture"): texture = 1; break;
+            case AMaterialTable.Index("emissiveTexture"):  texture = 2; break;
+            case AMaterialTable.Index("emissiveFactor"): 
+                curr = ParseFloat16(curr, material.emissiveFactor[0]); 
+                curr = ParseFloat16(curr, material.emissiveFactor[1]);
+                curr = ParseFloat16(curr, material.emissiveFactor[2]);
+                curr = SkipUntill(curr, ']');
+                curr++;
+                break;
+            case AMaterialTable.Index("extensions"):
+                curr = SkipToNextNode(curr, '{'); // currently extensions are not supported 
+                break;
+            case AMaterialTable.Index("alphaMode"):
+            {
+                curr += sizeof("alphaMode'");
+                curr = SkipUntill(curr, '"');
+                curr++;
+                switch (FindKeyword(AAlphaModeTable, curr))
+                {
+                    case AAlphaModeTable.Index("OPAQUE"): material.alphaMode = AMaterialAlphaMode_Opaque; break;
+                    case AAlphaModeTable.Index("MASK"):   material.alphaMode = AMaterialAlphaMode_Mask;   break;
+                    case AAlphaModeTable.Index("BLEND"):  material.alphaMode = AMaterialAlphaMode_Blend;  break;
+                }
+                curr = SkipAfter(curr, '"');
+                break;
+            }
+            case AMaterialTable.Index("alphaCutoff"):
+                material.alphaCutoff = ParseFloat(curr);
+                break;
+            default:
+                ASSERT(0 && "undefined material variable!");
+                return (const char*)AError_UNKNOWN_MATERIAL_VAR;
+        }
+
+        if (texture != -1)
+        {
+            curr = ParseMaterialTexture(curr, material.textures[texture]);
+            if ((uint64_t)curr == AError_UNKNOWN_MATERIAL_VAR) return curr;
+        }
+    }
+    return curr;
+}
+
+static constexpr const char* ASkinKeys[] = { "inverseBindMatrices", "skeleton", "name", "joints" };
+static constexpr AKeywordTable<ArraySize(ASkinKeys)> ASkinTable(ASkinKeys);
+
+static const char* ParseSkins(const char* curr, Array<ASkin>& skins, AStringAllocator& stringAllocator, AIntAllocator& intAllocator)
+{
+    curr = SkipAfter(curr, '[');
+    
+    ASkin skin{};
+    skin.skeleton = -1;
+
+    // read each node
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}')
+            {
+                skins.Add(skin);
+                MemsetZero(&skin, sizeof(ASkin));
+                skin.skeleton = -1;
+            }
+            if (*curr++ == ']') return curr; // end all nodes
+        }
+        ASSERT(*curr != '\0' && "parsing skins not possible, probably forgot to close brackets!");
+        curr++; // skips the "
+
+        switch (FindKeyword(ASkinTable, curr))
+        {
+            case ASkinTable.Index("inverseBindMatrices"):
+                // we will parse later, because we are not sure we are parsed accessors at this point
+                skin.inverseBindMatrices = (float*)(size_t)ParsePositiveNumber(curr);
+                break;
+            case ASkinTable.Index("skeleton"): skin.skeleton = ParsePositiveNumber(curr); break;
+            case ASkinTable.Index("name"):     curr = CopyStringInQuotes(skin.name, curr + 5, stringAllocator); break;
+            case ASkinTable.Index("joints"):
+            {
+                IntPtrPair result = ParseIntArray(curr, intAllocator);
+                skin.numJoints = result.numElements;
+                skin.joints = result.ptr;
+                curr++; // skip ]
+                break;
+            }
+        }
+    }
+    return curr;
+}
+
+static constexpr const char* AAnimationKeys[]   = { "name", "channels", "samplers" };
+static constexpr const char* AChannelKeys[]     = { "sampler", "node", "target", "path" };
+static constexpr const char* AAnimSamplerKeys[] = { "input", "output", "interpolation" };
+static constexpr AKeywordTable<ArraySize(AAnimationKeys)>   AAnimationTable(AAnimationKeys);
+static constexpr AKeywordTable<ArraySize(AChannelKeys)>     AChannelTable(AChannelKeys);
+static constexpr AKeywordTable<ArraySize(AAnimSamplerKeys)> AAnimSamplerTable(AAnimSamplerKeys);
+
+static const char* ParseAnimations(const char* curr, Array<AAnimation>& animations, 
+                                   AStringAllocator& stringAllocator, AIntAllocator& intAllocator)
+{
+    curr = SkipAfter(curr, '[');
+    Array<AAnimChannel> channels;
+    Array<AAnimSampler> samplers;
+
+    AAnimation animation{};
+    // read each node
+    while (true)
+    {
+        // search for name
+        while (*(curr = NextStructural(curr)) && *curr != '"')
+        {
+            if (*curr == '}')
+            {
+                animation.numSamplers = samplers.Size();
+                animation.numChannels = channels.Size();
+                animation.samplers = samplers.TakeOwnership();
+                animation.channels = channels.TakeOwnership();
+                animations.Add(animation);
+                MemsetZero(&animation, sizeof(AAnimation));
+            }
+            if (*curr++ == ']') 
+                return curr; // end all nodes
+        }
+        ASSERT(*curr != '\0' && "parsing animations not possible, probably forgot to close brackets!");
+        curr++; // skips the "
+        int key = FindKeyword(AAnimationTable, curr);
+
+        if (key == AAnimationTable.Index("name"))
+        {
+            curr = CopyStringInQuotes(animation.name, curr + sizeof("name'"), stringAllocator);
+        }
+        else if (key == AAnimationTable.Index("channels"))
+        {
+            curr += sizeof("channels'");
+            AAnimChannel channel;
+            bool parsingTarget = false;
+            while (true)
+            {
+                while (*(curr = NextStructural(curr)) && *curr != '"')
+                {
+                    if (*curr == ']') { curr++; /* skip ] */ goto end_parsing; }
+                    if (*curr == '}') 
+                    {
+                        if (parsingTarget) parsingTarget = false;
+                        else 
+                        {
+                            channels.Add(channel);
+                            MemsetZero(&channel, sizeof(AAnimChannel));
+                        }
+                    }
+                    curr++;
+                }
+                ASSERT(*curr != '\0' && "parsing anim channels not possible, probably forgot to close brackets!");
+
+                int channelKey = FindKeyword(AChannelTable, ++curr);
+                curr = SkipAfter(curr, '"');
+
+                switch (channelKey)
+                {
+                    case AChannelTable.Index("sampler"): channel.sampler = ParsePositiveNumber(curr);     break;
+                    case AChannelTable.Index("node"):    channel.targetNode = ParsePositiveNumber(curr);  break;
+                    case AChannelTable.Index("target"):  parsingTarget = true; break; 
+                    case AChannelTable.Index("path"):
+                    {
+                        curr = SkipAfter(curr, '"');
+                        switch (*curr) {
+                            case 't': channel.targetPath = AAnimTargetPath_Translation; break;
+                            case 'r': channel.targetPath = AAnimTargetPath_Rotation;    break;
+                            case 's': channel.targetPath = AAnimTargetPath_Scale;       break;
+                            default: ASSERT(0 && "Unknown animation path value");
+                        };
+                        curr = SkipAfter(curr, '"'); // skip path value
+                        break;
+                    }
+                    default: ASSERT(0 && "Unknown animation channel value");
+                };
+            }
+        }
+        else if (key == AAnimationTable.Index("samplers"))
+        {
+            curr += sizeof("samplers'");
+            AAnimSampler sampler;
+            while (true)
+            {
+                while (*(curr = NextStructural(curr)) && *curr != '"')
+                {
+                    if (*curr == ']') { curr++; /* skip ] */ goto end_parsing; }
+                    if (*curr == '}') 
+                    {
+                        samplers.Add(sampler);
+                        MemsetZero(&sampler, sizeof(AAnimSampler));
+                    }
+                    curr++;
+                }
+                ASSERT(*curr != '\0' && "parsing anim channels not possible, probably forgot to close brackets!");
+
+                int samplerKey = FindKeyword(AAnimSamplerTable, ++curr);
+                curr = SkipAfter(curr, '"');
+
+                switch (samplerKey)
+                {
+                    case AAnimSamplerTable.Index("input"):         sampler.input  = (float*)(size_t)ParsePositiveNumber(curr); break;
+                    case AAnimSamplerTable.Index("output"):        sampler.output = (float*)(size_t)ParsePositiveNumber(curr); break;
+                    case AAnimSamplerTable.Index("interpolation"):
+                    {
+                        curr = SkipAfter(curr, '"');
+                        switch (*curr)
+                        {
+                            case 'L': sampler.interpolation = 0; break; // Linear
+                            case 'S': sampler.interpolation = 1; break; // Step
+                            case 'C': sampler.interpolation = 2; break; // CubicSpline
+                            default: ASSERT(0 && "Unknown animation path value"); break;
+                        };
+                        curr = SkipAfter(curr, '"'); // skip interpolation value
+                        break;
+                    }
+                    default: ASSERT(0 && "Unknown animation sampler value"); break;
+                };
+            }
+        }
+        end_parsing:{}
+    }
+    return curr;
+}
+
+// https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#binary-gltf-layout
+enum AGLBMagic_
+{
+    AGLBMagic_Header = 0x46546C67, // glTF
+    AGLBMagic_JSON   = 0x4E4F534A, // JSON
+    AGLBMagic_BIN    = 0x004E4942  // BIN
+};
+
+struct AGLBHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t length;
+};
+
+// finds JSON and BIN chunks of .glb file, nothing is copied.
+// returns false if file is not valid glb. binChunk is null and binLength is zero if file has no BIN chunk
+__private bool ParseGLBChunks(const char* source, uint64_t sourceSize, const char** json, uint32_t* jsonLength, 
+                              const char** binChunk, uint32_t* binLength)
+{
+    AGLBHeader header;
+    if (sourceSize < sizeof(AGLBHeader) + 8) return false;
+    SmallMemCpy(&header, source, sizeof(AGLBHeader));
+    if (header.version != 2 || header.length > sourceSize) return false;
+
+    const char* chunk = source + sizeof(AGLBHeader);
+    const char* end   = source + header.length;
+    *jsonLength = (uint32_t)UnalignedLoad32(chunk);
+    uint32_t jsonType = (uint32_t)UnalignedLoad32(chunk + 4);
+    if (jsonType != AGLBMagic_JSON || chunk + 8 + *jsonLength > end) return false;
+
+    *json = chunk + 8;
+    const char* bin = *json + *jsonLength;
+    *binChunk = nullptr;
+    *binLength = 0;
+    // BIN chunk is optional, it's header comes right after json
+    if (bin + 8 <= end && UnalignedLoad32(bin + 4) == AGLBMagic_BIN)
+    {
+        *binLength = (uint32_t)UnalignedLoad32(bin);
+        if (bin + 8 + *binLength > end) return false;
+        *binChunk = bin + 8;
+    }
+    return true;
+}
+
+/*****************************************************************
+*                        Sparse Accessors                        *
+*****************************************************************/
+
+// bytes per component, indexed by componentType (GL_BYTE is 0)
+static const int AComponentSizes[] = { 1, 1, 2, 2, 4, 4, 4 };
+
+__private uint32_t SparseIndex(const ASparseAccessor* sparse, int i)
+{
+    switch (sparse->indexType)
+    {
+        case 1:  return ((const uint8_t*)sparse->indices)[i];  // GL_UNSIGNED_BYTE
+        case 3:  return ((const uint16_t*)sparse->indices)[i]; // GL_UNSIGNED_SHORT
+        default: return ((const uint32_t*)sparse->indices)[i]; // GL_UNSIGNED_INT
+    }
+}
+
+__public int ASparseElementSize(const ASparseAccessor* sparse)
+{
+    if (sparse->componentType < 0 || sparse->componentType >= (int)ArraySize(AComponentSizes)) return 0;
+    return AComponentSizes[sparse->componentType] * sparse->numComponents;
+}
+
+__public void ASparseApply(const ASparseAccessor* sparse, void* dst, int stride)
+{
+    int size = ASparseElementSize(sparse);
+    if (stride == 0) stride = size;
+    const char* values = (const char*)sparse->values;
+    if (values == nullptr || sparse->indices == nullptr) return; // buffer is not loaded
+    
+    for (int i = 0; i < sparse->count; i++, values += size)
+    {
+        uint32_t index = SparseIndex(sparse, i);
+        if (index < (uint32_t)sparse->numElements) 
+            SmallMemCpy((char*)dst + (int64_t)index * stride, values, size);
+    }
+}
+
+__public void ASparseCopy(const ASparseAccessor* sparse, void* dst)
+{
+    int size = ASparseElementSize(sparse);
+    int64_t numBytes = (int64_t)size * sparse->numElements;
+    const char* base = (const char*)sparse->base;
+    
+    if (base == nullptr) 
+    {
+        MemsetZero(dst, numBytes);
+    }
+    else if (sparse->byteStride == 0 || sparse->byteStride == size) 
+    {
+        SmallMemCpy(dst, base, numBytes);
+    }
+    else 
+    {
+        for (int i = 0; i < sparse->numElements; i++)
+            SmallMemCpy((char*)dst + (int64_t)i * size, base + (int64_t)i * sparse->byteStride, size);
+    }
+    
+    ASparseApply(sparse, dst, 0);
+}
+
+__public const void* ASparseGetDense(ASparseAccessor* sparse)
+{
+    if (sparse->dense) return sparse->dense;
+    int64_t numBytes = (int64_t)ASparseElementSize(sparse) * sparse->numElements;
+    sparse->dense = AllocAligned(MAX(numBytes, (int64_t)16), 16);
+    ASparseCopy(sparse, sparse->dense);
+    return sparse->dense;
+}
+
+// returns null if buffer is not loaded
+__private void* SparseData(const Array<GLTFBufferView>& bufferViews, const Array<GLTFBuffer>& buffers, int view, int64_t offset)
+{
+    const GLTFBufferView& bufferView = bufferViews[view];
+    void* uri = buffers[bufferView.buffer].uri;
+    return uri ? (char*)uri + offset + bufferView.byteOffset : nullptr;
+}
+
+// sparseIndices[accessor] is the index of the accessor in sparseAccessors, -1 if it's not sparse.
+// only filled if there is a sparse accessor
+__private AErrorType CreateSparseAccessors(const Array<GLTFAccessor>& accessors, const Array<GLTFBufferView>& bufferViews, 
+                                           const Array<GLTFBuffer>& buffers, Array<ASparseAccessor>& sparseAccessors, 
+                                           Array<int>& sparseIndices)
+{
+    int numSparse = 0;
+    for (int i = 0; i < accessors.Size(); i++)
+        numSparse += accessors[i].sparse != nullptr;
+    if (numSparse == 0) return AError_NONE;
+
+    // pointers to the elements are given to primitives, array must not grow after this
+    sparseAccessors.Reserve(numSparse);
+    sparseIndices.AddUninitialized(accessors.Size());
+
+    for (int i = 0; i < accessors.Size(); i++)
+    {
+        const GLTFAccessor& accessor = accessors[i];
+        sparseIndices[i] = -1;
+        if (accessor.sparse == nullptr) continue;
+
+        GLTFSparse sparse;
+        const char* parsed = ParseSparse(accessor.sparse, sparse);
+        if (parsed < (const char*)AError_MAX) return (AErrorType)(uint64_t)parsed;
+        
+        int numViews = bufferViews.Size();
+        if (sparse.indexView >= numViews || sparse.valueView >= numViews || (accessor.hasBufferView && accessor.bufferView >= numViews))
+            return AError_UNKNOWN_ACCESSOR_VAR;
+
+        ASparseAccessor result{};
+        result.base          = accessor.hasBufferView ? SparseData(bufferViews, buffers, accessor.bufferView, accessor.byteOffset) : nullptr;
+        result.byteStride    = accessor.hasBufferView ? bufferViews[accessor.bufferView].byteStride : 0;
+        result.indices       = SparseData(bufferViews, buffers, sparse.indexView, sparse.indexOffset);
+        result.values        = SparseData(bufferViews, buffers, sparse.valueView, sparse.valueOffset);
+        result.count         = sparse.count;
+        result.numElements   = accessor.count;
+        result.indexType     = sparse.indexType;
+        result.componentType = accessor.componentType;
+        result.numComponents = accessor.type;
+        
+        sparseIndices[i] = sparseAccessors.Size();
+        sparseAccessors.Add(result);
+    }
+    return AError_NONE;
+}
+
+/*****************************************************************
+*                       Selective Loading                        *
+*****************************************************************/
+
+// top level descriptors, ordered as selective loading parses them.
+// masks of each element only depends on the descriptors above it
+enum ASection_
+{
+    ASection_Scenes, ASection_Nodes, ASection_Meshes, ASection_Materials, 
+    ASection_Textures, ASection_Images, ASection_Samplers, ASection_Cameras, 
+    ASection_Skins, ASection_Animations, ASection_Accessors, ASection_BufferViews, ASection_Buffers, 
+    ASection_Count,
+    ASection_Scene = ASection_Count, ASection_Asset, ASection_Extensions, ASection_Unknown
+};
+typedef int ASection;
+
+// same order as ASection, extensionsRequired is the last one and it's also ASection_Extensions
+static constexpr const char* ASectionKeys[] = {
+    "scenes", "nodes", "meshes", "materials", "textures", "images", "samplers", "cameras", "skins", "animations", 
+    "accessors", "bufferViews", "buffers", "scene", "asset", "extensionsUsed", "extensionsRequired"
+};
+static constexpr AKeywordTable<ArraySize(ASectionKeys)> ASectionTable(ASectionKeys);
+static_assert(ArraySize(ASectionKeys) == ASection_Unknown + 1, "section keys must match ASection");
+
+__private ASection GetSection(const char* curr)
+{
+    int key = FindKeyword(ASectionTable, curr);
+    if (key == ASection_Unknown) return ASection_Extensions; // extensionsRequired
+    return key < 0 ? ASection_Unknown : key;
+}
+
+// finds start of each top level descriptor without parsing them, so we can parse them in dependency order
+// sectionEnds can be null, otherwise end of each section is written to it
+__private const char* IndexSections(const char* curr, const char* sections[ASection_Count], SceneBundle* result,
+                                    const char** sectionEnds = nullptr)
+{
+    while (*curr)
+    {
+        curr = SkipUntill(curr, '"');
+        if (*curr == '\0') break;
+        curr++; // skips the "
+
+        ASection section = GetSection(curr);
+        switch (section)
+        {
+            case ASection_Scene:      result->defaultSceneIndex = ParsePositiveNumber(curr); break;
+            case ASection_Asset:      curr = SkipToNextNode(curr, '{'); break;
+            case ASection_Extensions: curr = SkipToNextNode(curr, '['); break;
+            case ASection_Unknown:    ASSERT(0); return (const char*)AError_UNKNOWN_DESCRIPTOR;
+            default:
+                sections[section] = curr;
+                curr = SkipToNextNode(curr, '[');
+                if (sectionEnds) sectionEnds[section] = curr;
+                break;
+        }
+    }
+    return curr;
+}
+
+__private bool StringEqual(const char* a, const char* b)
+{
+    if (a == nullptr || b == nullptr) return false;
+    while (*a && *a == *b) a++, b++;
+    return *a == *b;
+}
+
+__private bool ContainsName(const char* const* names, int numNames, const char* name)
+{
+    for (int i = 0; i < numNames; i++)
+        if (StringEqual(names[i], name)) return true;
+    return false;
+}
+
+struct ASelection
+{
+    Array<uint8_t> nodes; // 1 if node or one of its parents is selected
+    Array<uint8_t> meshes;
+    Array<uint8_t> materials;
+    Array<uint8_t> skins;
+    Array<uint8_t> buffers;
+    int numSelected; // number of Select functions called, they are called in order
+};
+
+__private void SelectNodeHierarchy(Array<uint8_t>& nodeMask, const Array<ANode>& nodes, int root)
+{
+    if (root < 0 || root >= nodes.Size()) return;
+    Array<int> stack;
+    stack.Add(root);
+    while (stack.Size() > 0)
+    {
+        int index = stack.Back(); stack.RemoveBack();
+        if (nodeMask[index]) continue;
+        nodeMask[index] = 1;
+        const ANode& node = nodes[index];
+        for (int c = 0; c < node.numChildren; c++)
+            if (node.children[c] < nodes.Size()) stack.Add(node.children[c]);
+    }
+}
+
+// selects nodes of the scene and named nodes with their children, meshes of selected nodes
+__private void SelectNodes(ASelection& selection, const ALoadOptions* options, const Array<AScene>& scenes, 
+                           const Array<ANode>& nodes, int defaultScene)
+{
+    selection.nodes = Array<uint8_t>(nodes.Size(), (uint8_t)0);
+
+    if (options->flags & ALoadFlags_SelectScene)
+    {
+        int sceneIndex = options->sceneIndex < 0 ? defaultScene : options->sceneIndex;
+        ASSERT(sceneIndex < scenes.Size() && "selected scene is not exist");
+        if (sceneIndex < scenes.Size())
+        {
+            const AScene& scene = scenes[sceneIndex];
+            for (int i = 0; i < scene.numNodes; i++)
+                SelectNodeHierarchy(selection.nodes, nodes, scene.nodes[i]);
+        }
+    }
+
+    for (int i = 0; i < nodes.Size(); i++)
+        if (ContainsName(options->nodeNames, options->numNodeNames, nodes[i].name))
+            SelectNodeHierarchy(selection.nodes, nodes, i);
+
+    for (int i = 0; i < nodes.Size(); i++)
+        if (selection.nodes[i] && nodes[i].type == 0 && nodes[i].index >= 0)
+            Select(selection.meshes, nodes[i].index);
+}
+
+// meshes are fully parsed if there are mesh names, we remove the ones that are not selected here.
+// selects materials that selected meshes use
+__private void SelectMeshes(ASelection& selection, const ALoadOptions* options, Array<AMesh>& meshes, const Array<ANode>& nodes)
+{
+    for (int m = 0; m < meshes.Size() && options->numMeshNames > 0; m++)
+    {
+        if (ContainsName(options->meshNames, options->numMeshNames, meshes[m].name)) 
+            Select(selection.meshes, m);
+        
+        if (IsSelected(selection.meshes, m)) continue;
+        SBFree(meshes[m].primitives);
+        MemsetZero(&meshes[m], sizeof(AMesh));
+    }
+
+    // nodes that use selected meshes, so we can load their skins and animations
+    for (int i = 0; i < nodes.Size(); i++)
+        if (nodes[i].type == 0 && IsSelected(selection.meshes, nodes[i].index))
+            selection.nodes[i] = 1;
+
+    for (int m = 0; m < meshes.Size(); m++)
+        for (int p = 0; p < meshes[m].numPrimitives; p++)
+            if (meshes[m].primitives[p].material >= 0) 
+                Select(selection.materials, meshes[m].primitives[p].material);
+}
+
+__private void SelectAccessor(ASelection& selection, const Array<GLTFAccessor>& accessors, 
+                              const Array<GLTFBufferView>& bufferViews, int accessor)
+{
+    if (accessor < 0 || accessor >= accessors.Size()) return;
+    const GLTFAccessor& gltfAccessor = accessors[accessor];
+    int views[3] = { gltfAccessor.hasBufferView ? gltfAccessor.bufferView : -1, -1, -1 };
+    
+    GLTFSparse sparse;
+    if (gltfAccessor.sparse && ParseSparse(gltfAccessor.sparse, sparse) >= (const char*)AError_MAX)
+        views[1] = sparse.indexView, views[2] = sparse.valueView;
+
+    for (int i = 0; i < 3; i++)
+    {
+        int view = views[i];
+        if (view < 0 || view >= bufferViews.Size()) continue;
+        if (bufferViews[view].buffer >= 0) Select(selection.buffers, bufferViews[view].buffer);
+    }
+}
+
+// selects skins of selected meshes and animations that targets selected nodes,
+// removes rest of the animations, then selects buffers that are used by selected accessors
+__private void SelectBuffers(ASelection& selection, const Array<ANode>& nodes, const Array<AMesh>& meshes, 
+                             const Array<ASkin>& skins, Array<AAnimation>& animations, const Array<GLTFAccessor>& accessors, 
+                             const Array<GLTFBufferView>& bufferViews)
+{
+    // skin of skinned mesh might be out of selected hierarchy, we select it's joints too
+    for (int i = 0; i < nodes.Size(); i++)
+    {
+        const ANode& node = nodes[i];
+        if (!selection.nodes[i] || node.type != 0 || !IsSelected(selection.meshes, node.index)) continue;
+        if (node.skin < 0 || node.skin >= skins.Size()) continue;
+        
+        const AMesh& mesh = meshes[node.index];
+        for (int p = 0; p < mesh.numPrimitives; p++)
+            if (mesh.primitives[p].attributes & AAttribType_JOINTS) 
+                Select(selection.skins, node.skin);
+    }
+    
+    for (int s = 0; s < skins.Size(); s++)
+    {
+        for (int j = 0; j < skins[s].numJoints && !IsSelected(selection.skins, s); j++)
+            if (IsSelected(selection.nodes, skins[s].joints[j])) Select(selection.skins, s);
+        
+        for (int j = 0; j < skins[s].numJoints && IsSelected(selection.skins, s); j++)
+            if (skins[s].joints[j] < nodes.Size()) selection.nodes[skins[s].joints[j]] = 1;
+    }
+
+    // animations are not referenced by index, so we can remove them
+    int numAnimations = 0;
+    for (int a = 0; a < animations.Size(); a++)
+    {
+        AAnimation& animation = animations[a];
+        bool selected = false;
+        for (int c = 0; c < animation.numChannels && !selected; c++)
+        {
+            int target = animation.channels[c].targetNode;
+            selected = IsSelected(selection.nodes, target);
+        }
+
+        if (selected) { animations[numAnimations++] = animation; continue; }
+        FreeAligned(animation.samplers);
+        FreeAligned(animation.channels);
+    }
+    animations.Resize(numAnimations);
+
+    for (int m = 0; m < meshes.Size(); m++)
+    {
+        for (int p = 0; p < meshes[m].numPrimitives; p++)
+        {
+            const APrimitive& primitive = meshes[m].primitives[p];
+            SelectAccessor(selection, accessors, bufferViews, primitive.indiceIndex);
+            unsigned attributes = primitive.attributes;
+            for (int j = 0; attributes > 0 && j < AAttribType_Count; j += NextSetBit(&attributes))
+                SelectAccessor(selection, accessors, bufferViews, (int)(size_t)primitive.vertexAttribs[j]);
+        }
+    }
+
+    for (int s = 0; s < skins.Size(); s++)
+        if (IsSelected(selection.skins, s)) 
+            SelectAccessor(selection, accessors, bufferViews, (int)(size_t)skins[s].inverseBindMatrices);
+
+    for (int a = 0; a < animations.Size(); a++)
+        for (int s = 0; s < animations[a].numSamplers; s++)
+        {
+            SelectAccessor(selection, accessors, bufferViews, (int)(size_t)animations[a].samplers[s].input);
+            SelectAccessor(selection, accessors, bufferViews, (int)(size_t)animations[a].samplers[s].output);
+        }
+}
+
+// descriptor arrays and the inputs that section parsers need
+struct AParseTarget
+{
+    Array<GLTFBufferView> bufferViews;
+    Array<GLTFBuffer>     buffers;
+    Array<GLTFAccessor>   accessors;
+
+    Array<AMesh>  meshes; Array<ANode>        nodes; Array<AMaterial> materials; Array<ATexture>  textures;
+    Array<AImage> images; Array<ASampler>  samplers; Array<ACamera>     cameras; Array<AScene>    scenes;
+    Array<ASkin>  skins; Array<AAnimation> animations;
+
+    const char* path;
+    const char* binChunk;
+    uint64_t binChunkSize;
+    AUriResolver resolver;
+    void* userData;
+    ABufferReadQueue* readQueue; // null if buffers are not read asynchronously
+    ALoadFlags flags;
+    float scale;
+    int arrayThreads; // number of threads that big arrays are split between, 1 is serial
+};
+
+// counting pre-pass, allocates the array of the section with exact size so it never grows while parsing
+// primitiveCounts is only used with meshes, it can be null
+__private void ReserveSection(AParseTarget& t, ASection section, const char* curr, Array<int>* primitiveCounts)
+{
+    if (section >= ASection_Count) return; // scene, asset and extensions are not arrays of objects
+    curr = SkipUntill(curr, '[');
+    int count = CountArrayElements(curr, primitiveCounts);
+    switch (section)
+    {
+        case ASection_Accessors:   t.accessors.Reserve(t.accessors.Size() + count);     break;
+        case ASection_Scenes:      t.scenes.Reserve(t.scenes.Size() + count);           break;
+        case ASection_BufferViews: t.bufferViews.Reserve(t.bufferViews.Size() + count); break;
+        case ASection_Buffers:     t.buffers.Reserve(t.buffers.Size() + count);         break;
+        case ASection_Images:      t.images.Reserve(t.images.Size() + count);           break;
+        case ASection_Textures:    t.textures.Reserve(t.textures.Size() + count);       break;
+        case ASection_Meshes:      t.meshes.Reserve(t.meshes.Size() + count);           break;
+        case ASection_Materials:   t.materials.Reserve(t.materials.Size() + count);     break;
+        case ASection_Nodes:       t.nodes.Reserve(t.nodes.Size() + count);             break;
+        case ASection_Samplers:    t.samplers.Reserve(t.samplers.Size() + count);       break;
+        case ASection_Cameras:     t.cameras.Reserve(t.cameras.Size() + count);         break;
+        case ASection_Skins:       t.skins.Reserve(t.skins.Size() + count);             break;
+        case ASection_Animations:  t.animations.Reserve(t.animations.Size() + count);   break;
+        default: break;
+    }
+}
+
+// with counting, primitives of each mesh are counted too so primitive arrays are allocated once
+__private const char* ParseMeshSection(AParseTarget& t, const char* curr, AStringAllocator& stringAllocator, const Array<uint8_t>* meshMask)
+{
+    if (!(t.flags & ALoadFlags_CountElements))
+        return ParseMeshes(curr, t.meshes, stringAllocator, meshMask, nullptr);
+    
+    Array<int> primitiveCounts;
+    ReserveSection(t, ASection_Meshes, curr, &primitiveCounts);
+    return ParseMeshes(curr, t.meshes, stringAllocator, meshMask, &primitiveCounts);
+}
+
+// parses one top level array, each section writes to a different array of target so sections can be parsed concurrently
+// masks can be null, see selective loading
+__private const char* ParseSection(AParseTarget& target, ASection section, const char* curr,
+                                   AStringAllocator& stringAllocator, AIntAllocator& intAllocator,
+                                   const Array<uint8_t>* meshMask, const Array<uint8_t>* materialMask, const Array<uint8_t>* bufferMask)
+{
+    AParseTarget& t = target;
+    if ((t.flags & ALoadFlags_CountElements) && section != ASection_Meshes) 
+        ReserveSection(t, section, curr, nullptr);
+
+    switch (section)
+    {
+        case ASection_Accessors:   return ParseAccessors(curr, t.accessors, t.arrayThreads);
+        case ASection_Scenes:      return ParseScenes(curr, t.scenes, stringAllocator, intAllocator);
+        case ASection_BufferViews: return ParseBufferViews(curr, t.bufferViews);
+        case ASection_Buffers:
+            curr = ParseBuffers(curr, t.path, t.buffers, t.binChunk, t.binChunkSize, t.flags, t.readQueue, t.resolver, t.userData, bufferMask);
+            if (t.readQueue && curr >= (const char*)AError_MAX) StartBufferReads(*t.readQueue, t.buffers);
+            return curr;
+        case ASection_Images:      return ParseImages(curr, t.path, t.images, stringAllocator, t.resolver, t.userData);
+        case ASection_Textures:    return ParseTextures(curr, t.textures, stringAllocator);
+        case ASection_Meshes:      return ParseMeshSection(t, curr, stringAllocator, meshMask);
+        case ASection_Materials:   return ParseMaterials(curr, t.materials, stringAllocator, materialMask);
+        case ASection_Nodes:       return ParseNodes(curr, t.nodes, stringAllocator, intAllocator, t.scale, t.arrayThreads);
+        case ASection_Samplers:    return ParseSamplers(curr, t.samplers);
+        case ASection_Cameras:     return ParseCameras(curr, t.cameras, stringAllocator);
+        case ASection_Skins:       return ParseSkins(curr, t.skins, stringAllocator, intAllocator);
+        case ASection_Animations:  return ParseAnimations(curr, t.animations, stringAllocator, intAllocator);
+        case ASection_Asset:       return SkipToNextNode(curr, '{'); // it just has text data that doesn't have anything to do with meshes, (author etc..) if you want you can add this feature :)
+        case ASection_Extensions:  return SkipToNextNode(curr, '[');
+        default: ASSERT(0); return (const char*)AError_UNKNOWN_DESCRIPTOR;
+    }
+}
+
+struct AParallelSections
+{
+    AParseTarget* target;
+    const char* sections[ASection_Count]; // start of each section, null if not exist
+    const char* results[ASection_Count];  // end of the section or error
+    ASection order[ASection_Count];       // existing sections, largest first
+    AStringAllocator* stringAllocators;   // one per section
+    AIntAllocator*    intAllocators;
+};
+
+static void ParseSectionTask(int index, void* arg)
+{
+    AParallelSections* parallel = (AParallelSections*)arg;
+    ASection section = parallel->order[index];
+    parallel->results[section] = ParseSection(*parallel->target, section, parallel->sections[section],
+                                              parallel->stringAllocators[section], parallel->intAllocators[section], 
+                                              nullptr, nullptr, nullptr);
+}
+
+// parses each section on its own thread with its own allocators, allocators are linked to the given ones at the end.
+// parse takes as long as the largest section. returns json or error
+__private const char* ParseSectionsParallel(AParseTarget& target, const char* json, SceneBundle* result, int numThreads,
+                                            AStringAllocator& stringAllocator, AIntAllocator& intAllocator)
+{
+    AParallelSections parallel{};
+    const char* ends[ASection_Count] = {};
+    const char* indexed = IndexSections(json, parallel.sections, result, ends);
+    if (indexed < (const char*)AError_MAX) return indexed;
+
+    int numSections = 0;
+    for (int i = 0; i < ASection_Count; i++)
+    {
+        if (parallel.sections[i] == nullptr) continue;
+        // insertion sort by size, so the largest sections start first
+        int j = numSections++;
+        for (; j > 0 && ends[parallel.order[j - 1]] - parallel.sections[parallel.order[j - 1]] < ends[i] - parallel.sections[i]; j--)
+            parallel.order[j] = parallel.order[j - 1];
+        parallel.order[j] = i;
+    }
+
+    AStringAllocator stringAllocators[ASection_Count];
+    AIntAllocator    intAllocators[ASection_Count];
+    parallel.target           = &target;
+    parallel.stringAllocators = stringAllocators;
+    parallel.intAllocators    = intAllocators;
+    // sections already keep the threads busy, arrays are parsed serially in them instead of creating nested threads
+    int arrayThreads = target.arrayThreads;
+    target.arrayThreads = 1;
+    AParallelFor(numSections, ParseSectionTask, &parallel, numThreads);
+    target.arrayThreads = arrayThreads;
+
+    for (int i = 0; i < ASection_Count; i++)
+    {
+        stringAllocator.Append(stringAllocators[i]);
+        intAllocator.Append(intAllocators[i]);
+    }
+
+    // report the first error in section order, so it is same for every run
+    for (int i = 0; i < ASection_Count; i++)
+        if (parallel.sections[i] && parallel.results[i] < (const char*)AError_MAX)
+            return parallel.results[i];
+    return json;
+}
+
+__private void MoveSceneToArena(SceneBundle* scene);
+
+// frees the memory that parsed descriptors own, arrays of the target are freed by their destructors.
+// used when loading fails, arrays only contain fully parsed elements. same as the FreeGLTF but before the scene is created
+__private void FreeParseTarget(AParseTarget& t)
+{
+    for (int i = 0; i < t.meshes.Size(); i++)
+        SBFree(t.meshes[i].primitives);
+
+    for (int i = 0; i < t.images.Size(); i++)
+        if (t.images[i].ownsData) AX_FREE(t.images[i].data);
+
+    for (int i = 0; i < t.animations.Size(); i++)
+    {
+        if (t.animations[i].samplers) FreeAligned(t.animations[i].samplers);
+        if (t.animations[i].channels) FreeAligned(t.animations[i].channels);
+    }
+
+    for (int i = 0; i < t.buffers.Size(); i++)
+    {
+        GLTFBuffer& buffer = t.buffers[i];
+        if (buffer.flags & ABufferFlag_Mapped)
+            AUnmapFile(buffer.uri, buffer.mappedSize);
+        else if (!(buffer.flags & (ABufferFlag_GLB | ABufferFlag_External)))
+            FreeAllText((char*)buffer.uri);
+        buffer.uri = nullptr;
+    }
+}
+
+// json must be null terminated, result must be zero initialized.
+// path is used for finding .bin and image files, if resolver is not null uris are resolved with it instead
+__private int ParseGLTFJson(const char* json, const char* path, const char* binChunk, uint64_t binChunkSize, 
+                            AUriResolver resolver, void* userData, SceneBundle* result, float scale, const ALoadOptions* options)
+{
+    ALoadFlags flags = options ? options->flags : ALoadFlags_None;
+#if defined(DEBUG) || defined(_DEBUG)
+    // ascii utf8 support check
+    // if (IsUTF8ASCII(source, sourceSize) != 1) { result->error = AError_NON_UTF8; return; }
+#endif
+    AParseTarget target;
+    Array<GLTFBufferView>& bufferViews = target.bufferViews;
+    Array<GLTFBuffer>&     buffers     = target.buffers;
+    Array<GLTFAccessor>&   accessors   = target.accessors;
+
+    AStringAllocator stringAllocator(2048);
+    FixedSizeGrowableAllocator<int> intAllocator(512);
+
+    Array<AMesh>&  meshes = target.meshes; Array<ANode>&        nodes = target.nodes; 
+    Array<AImage>& images = target.images; Array<ASampler>&  samplers = target.samplers; 
+    Array<ASkin>&  skins  = target.skins;  Array<AAnimation>& animations = target.animations;
+    Array<AMaterial>& materials = target.materials; Array<ATexture>& textures = target.textures;
+    Array<ACamera>&   cameras   = target.cameras;   Array<AScene>&   scenes   = target.scenes;
+
+    // mapping is already lazy, there is nothing to overlap with parsing
+    bool asyncReads = (flags & ALoadFlags_AsyncBuffers) && !(flags & ALoadFlags_MapBuffers);
+    ABufferReadQueue readQueue{};
+
+    target.path      = path;
+    target.binChunk  = binChunk;
+    target.binChunkSize = binChunkSize;
+    target.resolver  = resolver;
+    target.userData  = userData;
+    target.readQueue = asyncReads ? &readQueue : nullptr;
+    target.flags     = flags;
+    target.scale     = scale;
+    target.arrayThreads = 1;
+    if (flags & ALoadFlags_ParallelArrays)
+        target.arrayThreads = options->numThreads > 0 ? options->numThreads : ANumHardwareThreads();
+
+    // selective loading parses descriptors in dependency order, 
+    // so we know which elements and buffers are needed before parsing them
+    const char* sections[ASection_Count] = {};
+    ASelection selection{};
+    bool selective = options && ((options->flags & ALoadFlags_SelectScene) || options->numNodeNames > 0 || options->numMeshNames > 0);
+    if (selective)
+    {
+        const char* indexed = IndexSections(json, sections, result);
+        if (indexed < (const char*)AError_MAX) { result->error = (AErrorType)(uint64_t)indexed; return 0; }
+    }
+
+    // selective loading needs dependency order, so it is always serial
+    const char* curr = json;
+    if (!selective && (flags & ALoadFlags_ParallelSections))
+    {
+        curr = ParseSectionsParallel(target, json, result, options->numThreads, stringAllocator, intAllocator);
+        if (curr < (const char*)AError_MAX)
+        {
+            WaitBufferReads(readQueue);
+            FreeParseTarget(target);
+            result->error = (AErrorType)(uint64_t)curr;
+            return 0;
+        }
+        static const char emptyJson[AReadPadding] = {}; // padded like the json text, scanners load whole blocks
+        curr = emptyJson; // all sections are parsed, skip the loop below
+    }
+
+    int nextSection = 0;
+    while (true)
+    {
+        ASection section;
+        if (selective)
+        {
+            AX_NO_UNROLL while (nextSection < ASection_Count && sections[nextSection] == nullptr) nextSection++;
+            section = nextSection++;
+
+            // compute masks that are needed by this descriptor, all dependencies are parsed
+            if (section >= ASection_Meshes && selection.numSelected == 0) 
+                SelectNodes(selection, options, scenes, nodes, result->defaultSceneIndex), selection.numSelected++;
+            if (section >= ASection_Materials && selection.numSelected == 1) 
+                SelectMeshes(selection, options, meshes, nodes), selection.numSelected++;
+            if (section >= ASection_Buffers && selection.numSelected == 2)
+                SelectBuffers(selection, nodes, meshes, skins, animations, accessors, bufferViews), selection.numSelected++;
+            
+            if (section >= ASection_Count) break;
+            curr = sections[section];
+        }
+        else
+        {
+            // search for descriptor for example, accessors, materials, images, samplers
+            curr = SkipUntill(curr, '"');
+            if (*curr == '\0') break;
+            curr++; // skips the "
+            section = GetSection(curr);
+        }
+
+        // mesh masks are null if there are mesh names, because we don't know names before parsing them
+        const Array<uint8_t>* meshMask     = selective && options->numMeshNames == 0 ? &selection.meshes : nullptr;
+        const Array<uint8_t>* materialMask = selective ? &selection.materials : nullptr;
+        const Array<uint8_t>* bufferMask   = selective ? &selection.buffers   : nullptr;
+
+        if (section == ASection_Scene) result->defaultSceneIndex = ParsePositiveNumber(curr);
+        else curr = ParseSection(target, section, curr, stringAllocator, intAllocator, meshMask, materialMask, bufferMask);
+
+        if (curr < (const char*)AError_MAX) // is failed?
+        {
+            WaitBufferReads(readQueue);
+            FreeParseTarget(target);
+            result->error = (AErrorType)(uint64_t)curr;
+            return 0;
+        }
+    }
+
+    // accessors below needs buffer memory, this is the only point we wait for io
+    AErrorType readError = WaitBufferReads(readQueue);
+    if (readError != AError_NONE)
+    {
+        FreeParseTarget(target);
+        result->error = readError;
+        return 0;
+    }
+
+    Array<ASparseAccessor> sparseAccessors;
+    Array<int> sparseIndices;
+    AErrorType sparseError = CreateSparseAccessors(accessors, bufferViews, buffers, sparseAccessors, sparseIndices);
+    if (sparseError != AError_NONE)
+    {
+        FreeParseTarget(target);
+        result->error = sparseError;
+        return 0;
+    }
+
+    for (int m = 0; m < meshes.Size(); ++m)
+    {
+        // get number of vertex, getting first attribute count because all of the others are same
+        AMesh mesh = meshes[m];
+        mesh.numPrimitives = SBCount(mesh.primitives);
+        for (int p = 0; p < mesh.numPrimitives; p++)
+        {
+            APrimitive& primitive = mesh.primitives[p];
+            // get position attrib's count because all attributes same
+            int numVertex = accessors[(int)(size_t)primitive.vertexAttribs[0]].count; 
+            primitive.numVertices = numVertex;
+        
+            // get number of index
+            GLTFAccessor accessor = accessors[primitive.indiceIndex];
+            primitive.numIndices = accessor.count;
+
+            accessor = accessors[primitive.indiceIndex];
+            GLTFBufferView view = bufferViews[accessor.bufferView];
+            int64_t offset = (int64_t)accessor.byteOffset + view.byteOffset;
+            // copy indices
+            primitive.indices = ((char*)buffers[view.buffer].uri) + offset;
+            primitive.indexType = accessor.componentType;
+            primitive.sourceIndices     = primitive.indices;
+            primitive.sourceIndexType   = primitive.indexType;
+            primitive.numSourceVertices = primitive.numVertices;
+            
+            // get joint data that we need for creating vertices
+            const int jointIndex = TrailingZeroCount32(AAttribType_JOINTS);
+            accessor = accessors[(int)(size_t)primitive.vertexAttribs[jointIndex]];
+            primitive.jointType   = (short)accessor.componentType;
+            primitive.jointCount  = (short)accessor.type;
+            primitive.jointStride = (short)bufferViews[accessor.bufferView].byteStride;
+
+            // get weight data that we need for creating vertices
+            const int weightIndex = TrailingZeroCount32(AAttribType_WEIGHTS);
+            accessor = accessors[(int)(size_t)primitive.vertexAttribs[weightIndex]];
+            primitive.weightType   = (short)accessor.componentType;
+            primitive.weightStride = (short)bufferViews[accessor.bufferView].byteStride;
+
+            // AABB of the primitive, computed from positions if exporter didn't write min and max
+            accessor = accessors[(int)(size_t)primitive.vertexAttribs[0]];
+            view     = bufferViews[accessor.bufferView];
+            if (accessor.hasBounds == 3 && (primitive.attributes & AAttribType_POSITION))
+            {
+                SmallMemCpy(primitive.min, accessor.min, sizeof(accessor.min));
+                SmallMemCpy(primitive.max, accessor.max, sizeof(accessor.max));
+            }
+            else if ((primitive.attributes & AAttribType_POSITION) && accessor.componentType == 6 && !accessor.sparse && buffers[view.buffer].uri) // GL_FLOAT
+            {
+                // byteLength of the buffer is already checked against the loaded size, last position must be in the view
+                int stride = view.byteStride ? view.byteStride : 12;
+                int64_t lastByte = int64_t(accessor.byteOffset) + int64_t(accessor.count - 1) * stride + 12;
+                if (accessor.count > 0 && (lastByte > view.byteLength || int64_t(view.byteOffset) + view.byteLength > buffers[view.buffer].byteLength))
+                {
+                    for (int i = 0; i < sparseAccessors.Size(); i++) 
+                        if (sparseAccessors[i].dense) FreeAligned(sparseAccessors[i].dense);
+                    FreeParseTarget(target);
+                    result->error = AError_BUFFER_PARSE_FAIL;
+                    return 0;
+                }
+                const char* positions = (char*)buffers[view.buffer].uri + int64_t(accessor.byteOffset) + view.byteOffset;
+                PositionBounds(positions, accessor.count, stride, primitive.min, primitive.max);
+            }
+            else if ((primitive.attributes & AAttribType_POSITION) && accessor.componentType == 6 && accessor.sparse) // GL_FLOAT
+            {
+                // dense copy is tightly packed, it is also used for creating vertices later
+                ASparseAccessor& sparse = sparseAccessors[sparseIndices[(int)(size_t)primitive.vertexAttribs[0]]];
+                bool loaded = sparse.indices && sparse.values && (sparse.base || !accessor.hasBufferView);
+                if (loaded) PositionBounds((const char*)ASparseGetDense(&sparse), accessor.count, 12, primitive.min, primitive.max);
+            }
+
+            // position, normal, texcoord are different buffers, 
+            // we are unifying all attributes to Vertex* buffer here
+            // even though attrib definition in gltf is not ordered, this code will order it, because we traversing set bits
+            // for example it converts from this: TexCoord, Normal, Position to Position, Normal, TexCoord
+            unsigned attributes = primitive.attributes;
+            for (int j = 0; attributes > 0 && j < AAttribType_Count; j += NextSetBit(&attributes))
+            {
+                int accessorIndex = (int)(size_t)primitive.vertexAttribs[j];
+                accessor     = accessors[accessorIndex];
+                if (accessor.sparse)
+                {
+                    primitive.sparseAttributes |= 1u << j;
+                    primitive.vertexAttribs[j] = &sparseAccessors[sparseIndices[accessorIndex]];
+                    continue;
+                }
+                view         = bufferViews[accessor.bufferView];
+                offset       = int64_t(accessor.byteOffset) + view.byteOffset;
+                
+                primitive.vertexAttribs[j] = (char*)buffers[view.buffer].uri + offset;
+                primitive.vertexStrides[j] = (unsigned char)view.byteStride;
+            }
+        }
+    }
+
+    for (int s = 0; s < skins.Size(); s++)
+    {
+        ASkin& skin = skins[s];
+        if (selective && !IsSelected(selection.skins, s)) { skin.inverseBindMatrices = nullptr; continue; } // buffer is not loaded
+
+        size_t skinIndex = (size_t)skin.inverseBindMatrices;
+        if (accessors[(int)skinIndex].sparse)
+        {
+            skin.inverseBindMatrices = (float*)ASparseGetDense(&sparseAccessors[sparseIndices[(int)skinIndex]]);
+            continue;
+        }
+        GLTFAccessor   accessor  = accessors[(int)skinIndex];
+        GLTFBufferView view      = bufferViews[accessor.bufferView];
+        int64_t        offset    = int64_t(accessor.byteOffset) + view.byteOffset;
+        skin.inverseBindMatrices = (float*)((char*)buffers[view.buffer].uri + offset);
+    }
+
+    for (int a = 0; a < animations.Size(); a++)
+    {
+        AAnimation& animation = animations[a];
+        animation.duration = 0.0f;
+
+        for (int s = 0; s < animation.numSamplers; s++)
+        {
+            AAnimSampler& sampler = animation.samplers[s];
+            size_t inputIndex = (size_t)sampler.input;
+            GLTFAccessor   accessor  = accessors[(int)inputIndex];
+            GLTFBufferView view      = bufferViews[accessor.bufferView];
+            int64_t        offset    = int64_t(accessor.byteOffset) + view.byteOffset;
+            
+            sampler.input = (float*)((char*)buffers[view.buffer].uri + offset);
+            sampler.count = accessor.count;
+            if (accessor.sparse) sampler.input = (float*)ASparseGetDense(&sparseAccessors[sparseIndices[(int)inputIndex]]);
+            
+            size_t outputIndex = (size_t)sampler.output;
+            accessor = accessors[(int)outputIndex];
+            view     = bufferViews[accessor.bufferView];
+            offset   = int64_t(accessor.byteOffset) + view.byteOffset;
+            
+            sampler.output = (float*)((char*)buffers[view.buffer].uri + offset);
+            sampler.count = MIN(sampler.count, accessor.count);
+            if (accessor.sparse) sampler.output = (float*)ASparseGetDense(&sparseAccessors[sparseIndices[(int)outputIndex]]);
+            sampler.numComponent = accessor.type;
+            
+            animation.duration = MAX(animation.duration, sampler.input[sampler.count - 1]);
+        }
+    }
+
+    // calculate num vertices and indices
+    {
+        int totalVertexCount = 0;
+        int totalIndexCount = 0;
+        // Calculate total vertices, and indices
+        for (int m = 0; m < meshes.Size(); ++m)
+        {
+            AMesh mesh = meshes[m];
+            for (int p = 0; p < mesh.numPrimitives; p++)
+            {
+                APrimitive& primitive = mesh.primitives[p];
+                totalIndexCount  += primitive.numIndices;
+                totalVertexCount += primitive.numVertices;
+            }
+        }
+
+        result->totalIndices  = totalIndexCount;
+        result->totalVertices = totalVertexCount;
+    }
+
+    result->stringAllocator = stringAllocator.TakeOwnership();
+    result->intAllocator    = intAllocator.TakeOwnership();
+
+    result->numMeshes     = meshes.Size();     result->meshes     = meshes.TakeOwnership();
+    result->numNodes      = nodes.Size();      result->nodes      = nodes.TakeOwnership();
+    result->numMaterials  = materials.Size();  result->materials  = materials.TakeOwnership();
+    result->numTextures   = textures.Size();   result->textures   = textures.TakeOwnership(); 
+    result->numImages     = images.Size();     result->images     = images.TakeOwnership();
+    result->numSamplers   = samplers.Size();   result->samplers   = samplers.TakeOwnership();
+    result->numCameras    = cameras.Size();    result->cameras    = cameras.TakeOwnership();
+    result->numScenes     = scenes.Size();     result->scenes     = scenes.TakeOwnership();
+    result->numBuffers    = buffers.Size();    result->buffers    = buffers.TakeOwnership();
+    result->numAnimations = animations.Size(); result->animations = animations.TakeOwnership();
+    result->numSkins      = skins.Size();      result->skins      = skins.TakeOwnership();
+    result->numSparseAccessors = sparseAccessors.Size(); result->sparseAccessors = sparseAccessors.TakeOwnership();
+    result->scale = scale;
+    result->error = AError_NONE;
+    if (flags & ALoadFlags_Arena) MoveSceneToArena(result);
+    return 1;
+}
+
+__public int ParseGLTFEx(const char* path, SceneBundle* result, float scale, const ALoadOptions* options)
+{
+    ASSERT(result && path);
+    uint64_t sourceSize = 0;
+    char* source = ReadAllFile(path, nullptr, &sourceSize);
+    MemsetZero(result, sizeof(SceneBundle));
+
+    if (source == nullptr) { result->error = AError_FILE_NOT_FOUND; ASSERT(0); return 0; }
+
+    const char* json = source;
+    const char* binChunk = nullptr;
+    uint32_t binLength = 0;
+    bool isGLB = sourceSize >= 4 && UnalignedLoad32(source) == AGLBMagic_Header;
+    if (isGLB)
+    {
+        uint32_t jsonLength;
+        if (!ParseGLBChunks(source, sourceSize, &json, &jsonLength, &binChunk, &binLength)) 
+        { 
+            result->error = AError_INVALID_GLB; 
+            FreeAllText(source); 
+            return 0; 
+        }
+        // we already read the BIN chunk header, so we can use it's first byte for null terminating json.
+        // bytes after it are BIN chunk and file padding, so over-reads stays in the allocation
+        source[json - source + jsonLength] = '\0';
+    }
+
+    int parsed = ParseGLTFJson(json, path, binChunk, binLength, nullptr, nullptr, result, scale, options);
+
+    // glb buffer points into the source, we will free it with FreeGLTFBuffers
+    if (parsed && isGLB) result->glbSource = source;
+    else                 FreeAllText(source);
+    return parsed;
+}
+
+__public int ParseGLTFFromMemory(const char* data, unsigned long long size, SceneBundle* result, float scale, 
+                                 AUriResolver resolver, void* userData, const ALoadOptions* options)
+{
+    ASSERT(result && data);
+    MemsetZero(result, sizeof(SceneBundle));
+
+    const char* json = data;
+    uint64_t jsonLength = size;
+    const char* binChunk = nullptr;
+    uint32_t binLength = 0;
+    if (size >= 4 && UnalignedLoad32(data) == AGLBMagic_Header)
+    {
+        uint32_t glbJsonLength;
+        if (!ParseGLBChunks(data, size, &json, &glbJsonLength, &binChunk, &binLength)) 
+        { 
+            result->error = AError_INVALID_GLB; 
+            return 0; 
+        }
+        jsonLength = glbJsonLength;
+    }
+    
+    // parser needs null terminated and padded text so we copy the json, BIN chunk stays in callers memory
+    char* text = (char*)AX_MALLOC(jsonLength + AReadPadding);
+    SmallMemCpy(text, json, jsonLength);
+    MemsetZero(text + jsonLength, AReadPadding);
+    
+    int parsed = ParseGLTFJson(text, nullptr, binChunk, binLength, resolver, userData, result, scale, options);
+    FreeAllText(text);
+    return parsed;
+}
+
+__public int ParseGLTF(const char* path, SceneBundle* result, float scale)
+{
+    return ParseGLTFEx(path, result, scale, nullptr);
+}
+
+struct AParseBatch
+{
+    const char* const* paths;
+    SceneBundle* scenes;
+    const ALoadOptions* options;
+    float scale;
+};
+
+static void ParseBatchFile(int index, void* arg)
+{
+    AParseBatch* batch = (AParseBatch*)arg;
+    ParseGLTFEx(batch->paths[index], &batch->scenes[index], batch->scale, batch->options);
+}
+
+// parser has no global state, each file has it's own allocators so we can parse files concurrently
+__public int ParseGLTFBatch(const char* const* paths, SceneBundle* scenes, int numFiles, float scale, 
+                            const ALoadOptions* options, int numThreads)
+{
+    ASSERT(paths && scenes);
+    AParseBatch batch = { paths, scenes, options, scale };
+    AParallelFor(numFiles, ParseBatchFile, &batch, numThreads);
+
+    int numParsed = 0;
+    for (int i = 0; i < numFiles; i++)
+        numParsed += scenes[i].error == AError_NONE;
+    return numParsed;
+}
+
+__public float AParseFloat(const char* text, const char** end)
+{
+    const char* curr = text;
+    while (*curr && IsWhitespace(*curr)) curr++;
+    
+    if (!IsNumber(*curr) && !(*curr == '-' && IsNumber(curr[1])))
+    {
+        if (end) *end = text;
+        return 0.0f;
+    }
+    float value = ParseFloat(curr);
+    if (end) *end = curr;
+    return value;
+}
+
+__public void FreeGLTFBuffers(SceneBundle* gltf)
+{
+    for (int i = 0; i < gltf->numBuffers; i++)
+    {
+        GLTFBuffer& buffer = gltf->buffers[i];
+        if (buffer.flags & ABufferFlag_Mapped)
+            AUnmapFile(buffer.uri, buffer.mappedSize);
+        else if (!(buffer.flags & (ABufferFlag_GLB | ABufferFlag_External)))
+            FreeAllText((char*)buffer.uri);
+        buffer.uri = nullptr;
+    }
+    if (gltf->buffers && !gltf->cacheMapping && !gltf->arena) FreeAligned(gltf->buffers);
+    if (gltf->glbSource) FreeAllText((char*)gltf->glbSource);
+    gltf->numBuffers = 0;
+    gltf->buffers = nullptr;
+    gltf->glbSource = nullptr;
+}
+
+// true if ptr is owned by the scene, pointers into the cache mapping are freed with the mapping
+inline bool OwnedByScene(const SceneBundle* scene, const void* ptr)
+{
+    const char* mapping = (const char*)scene->cacheMapping;
+    return ptr && (!mapping || (const char*)ptr < mapping || (const char*)ptr >= mapping + scene->cacheSize);
+}
+
+// meshlets of a cached scene point into the mapping, unless AGenerateMeshlets is called after loading
+__private void FreeMeshlets(SceneBundle* scene)
+{
+    if (OwnedByScene(scene, scene->meshlets))         FreeAligned(scene->meshlets);
+    if (OwnedByScene(scene, scene->meshletVertices))  FreeAligned(scene->meshletVertices);
+    if (OwnedByScene(scene, scene->meshletTriangles)) FreeAligned(scene->meshletTriangles);
+    scene->meshlets = nullptr, scene->meshletVertices = nullptr, scene->meshletTriangles = nullptr;
+    scene->totalMeshlets = scene->totalMeshletVertices = scene->totalMeshletTriangles = 0;
+}
+
+__public void FreeGLTF(SceneBundle* gltf)
+{
+    struct CharFragment { 
+        CharFragment* next; char* ptr; int64_t   size;
+    };
+
+    struct IntFragment { 
+        IntFragment* next; int* ptr; int64_t   size;
+    };
+
+    if (gltf->cacheMapping)
+    {
+        // loaded with LoadGLTFCache, everything is in the mapping except dense copies, 
+        // vertices, indices and meshlets that are created after loading
+        for (int i = 0; i < gltf->numSparseAccessors; i++)
+        {
+            void* dense = gltf->sparseAccessors[i].dense;
+            if (OwnedByScene(gltf, dense)) FreeAligned(dense);
+        }
+        if (OwnedByScene(gltf, gltf->allVertices)) FreeAligned(gltf->allVertices);
+        if (OwnedByScene(gltf, gltf->allIndices))  FreeAligned(gltf->allIndices);
+        FreeMeshlets(gltf);
+        AUnmapFile(gltf->cacheMapping, gltf->cacheSize);
+        MemsetZero(gltf, sizeof(SceneBundle));
+        return;
+    }
+
+    FreeGLTFBuffers(gltf);
+
+    for (int i = 0; i < gltf->numSparseAccessors; i++)
+        if (gltf->sparseAccessors[i].dense) FreeAligned(gltf->sparseAccessors[i].dense);
+
+    if (gltf->arena)
+    {
+        // loaded with ALoadFlags_Arena, metadata is in one block
+        if (gltf->allVertices) FreeAligned(gltf->allVertices);
+        if (gltf->allIndices)  FreeAligned(gltf->allIndices);
+        FreeMeshlets(gltf);
+        FreeAligned(gltf->arena);
+        MemsetZero(gltf, sizeof(SceneBundle));
+        return;
+    }
+
+    if (gltf->stringAllocator)
+    {
+        // free allocators
+        CharFragment* base = (CharFragment*)gltf->stringAllocator;
+
+        while (base)
+        {
+            FreeAligned(base->ptr);
+            CharFragment* oldBase = base;
+            base = base->next;
+            FreeAligned(oldBase);
+        }
+    }
+    
+    if (gltf->intAllocator)
+    {
+        IntFragment* ibase = (IntFragment*)gltf->intAllocator;
+
+        while (ibase )
+        {
+            FreeAligned(ibase->ptr);
+            IntFragment* oldBase = ibase ;
+            ibase  = ibase->next;
+            FreeAligned(oldBase);
+        }
+    }
+
+    // also controls if arrays null or not
+    for (int i = 0; i < gltf->numMeshes; i++)
+        SBFree(gltf->meshes[i].primitives);
+
+    if (gltf->meshes)      FreeAligned(gltf->meshes);
+    if (gltf->nodes)       FreeAligned(gltf->nodes);
+    if (gltf->materials)   FreeAligned(gltf->materials);
+    if (gltf->textures)    FreeAligned(gltf->textures);
+    for (int i = 0; i < gltf->numImages; i++)
+        if (gltf->images[i].ownsData) AX_FREE(gltf->images[i].data);
+
+    if (gltf->images)      FreeAligned(gltf->images);
+    if (gltf->samplers)    FreeAligned(gltf->samplers);
+    if (gltf->cameras)     FreeAligned(gltf->cameras);
+    if (gltf->scenes)      FreeAligned(gltf->scenes);
+    if (gltf->skins)       FreeAligned(gltf->skins);
+    if (gltf->sparseAccessors) FreeAligned(gltf->sparseAccessors);
+    if (gltf->animations)
+    {
+        for (int i = 0; i < gltf->numAnimations; i++)
+        {
+            FreeAligned(gltf->animations[i].samplers);
+            FreeAligned(gltf->animations[i].channels);
+        }
+        FreeAligned(gltf->animations);
+    }
+    if (gltf->allVertices) FreeAligned(gltf->allVertices);
+    if (gltf->allIndices)  FreeAligned(gltf->allIndices);
+    FreeMeshlets(gltf);
+    
+    MemsetZero(gltf, sizeof(SceneBundle));
+}
+
+/*****************************************************************
+*                             Cache                              *
+*****************************************************************/
+
+// file layout: ACacheHeader | buffers, dense sparse accessors, allVertices, allIndices | SceneBundle and metadata | relocations
+// pointers are stored as offsets from the start of the file, 0 is null.
+// relocations are offsets of the pointers in the file, loader adds mapping address to them.
+
+#include <stddef.h> // offsetof
+
+enum { ACacheMagic = 0x48434741, ACacheVersion = 6 }; // AGCH
+
+struct ACacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pointerSize;
+    uint32_t bundleSize;  // sizeof(SceneBundle), changes if structures change
+    uint64_t sourceSize;
+    uint64_t sourceTime;
+    uint64_t fileSize;
+    uint64_t sceneOffset;
+    uint64_t relocOffset;
+    uint64_t numRelocs;
+};
+
+struct ACacheRegion
+{
+    const char* data;
+    uint64_t size;
+    uint64_t offset; // offset in the file
+};
+
+struct ACacheWriter
+{
+    Array<char>         data;    // metadata, written after the regions
+    Array<uint64_t>     relocs;
+    Array<ACacheRegion> regions; // buffers, allVertices and allIndices
+    uint64_t            base;    // file offset of data
+    bool                inPlace; // arena, pointers into buffers are kept as they are
+};
+
+// returns file offset of the copied memory, 0 if src is null
+__private uint64_t CacheAppend(ACacheWriter& writer, const void* src, uint64_t size, int align = 16)
+{
+    if (src == nullptr) return 0;
+    while ((writer.data.Size() & (align - 1)) != 0) writer.data.Add('\0');
+    uint64_t offset = writer.base + writer.data.Size();
+    writer.data.AddUninitialized((int)size);
+    MemCpy(writer.data.Data() + (offset - writer.base), src, size);
+    return offset;
+}
+
+__private uint64_t CacheString(ACacheWriter& writer, const char* str)
+{
+    return str ? CacheAppend(writer, str, StringLength(str) + 1, 1) : 0;
+}
+
+// pointers into buffers, allVertices and allIndices
+__private uint64_t CacheRegionOffset(const ACacheWriter& writer, const void* ptr)
+{
+    if (ptr == nullptr) return 0;
+    for (int i = 0; i < writer.regions.Size(); i++)
+    {
+        const ACacheRegion& region = writer.regions[i];
+        if ((const char*)ptr >= region.data && (const char*)ptr <= region.data + region.size)
+            return region.offset + (uint64_t)((const char*)ptr - region.data);
+    }
+    ASSERT(0 && "pointer is not in any of the buffers");
+    return 0;
+}
+
+// fieldOffset is file offset of the pointer
+__private void CachePointer(ACacheWriter& writer, uint64_t fieldOffset, uint64_t target)
+{
+    uintptr_t value = (uintptr_t)target;
+    SmallMemCpy(writer.data.Data() + (fieldOffset - writer.base), &value, sizeof(uintptr_t));
+    if (target != 0) writer.relocs.Add(fieldOffset);
+}
+
+// pointer into buffers, allVertices or allIndices
+__private void CacheRegionPointer(ACacheWriter& writer, uint64_t fieldOffset, const void* ptr)
+{
+    if (!writer.inPlace) 
+    {
+        CachePointer(writer, fieldOffset, CacheRegionOffset(writer, ptr));
+        return;
+    }
+    // buffers are not moved, pointer doesn't need relocation
+    SmallMemCpy(writer.data.Data() + (fieldOffset - writer.base), &ptr, sizeof(void*));
+}
+
+#define CACHE_FIELD(arrayOffset, Type, index, field) ((arrayOffset) + sizeof(Type) * (index) + offsetof(Type, field))
+
+// returns file offset of the SceneBundle
+__private uint64_t CacheWriteMetadata(ACacheWriter& writer, const SceneBundle* scene)
+{
+    SceneBundle bundle = *scene;
+    bundle.stringAllocator = nullptr;
+    bundle.intAllocator    = nullptr;
+    bundle.glbSource       = nullptr;
+    bundle.cacheMapping    = nullptr;
+    bundle.cacheSize       = 0;
+    bundle.arena           = nullptr;
+    uint64_t so = CacheAppend(writer, &bundle, sizeof(SceneBundle));
+
+    CacheRegionPointer(writer, so + offsetof(SceneBundle, allVertices), scene->allVertices);
+    CacheRegionPointer(writer, so + offsetof(SceneBundle, allIndices),  scene->allIndices);
+
+    if (scene->meshlets)
+    {
+        uint64_t meshlets  = CacheAppend(writer, scene->meshlets, sizeof(AMeshlet) * scene->totalMeshlets);
+        uint64_t vertices  = CacheAppend(writer, scene->meshletVertices, sizeof(uint32_t) * scene->totalMeshletVertices);
+        uint64_t triangles = CacheAppend(writer, scene->meshletTriangles, 3ull * scene->totalMeshletTriangles);
+        CachePointer(writer, so + offsetof(SceneBundle, meshlets),         meshlets);
+        CachePointer(writer, so + offsetof(SceneBundle, meshletVertices),  vertices);
+        CachePointer(writer, so + offsetof(SceneBundle, meshletTriangles), triangles);
+    }
+
+    uint64_t sparse = CacheAppend(writer, scene->sparseAccessors, sizeof(ASparseAccessor) * scene->numSparseAccessors);
+    CachePointer(writer, so + offsetof(SceneBundle, sparseAccessors), sparse);
+    for (int i = 0; i < scene->numSparseAccessors; i++)
+    {
+        const ASparseAccessor& accessor = scene->sparseAccessors[i];
+        CacheRegionPointer(writer, CACHE_FIELD(sparse, ASparseAccessor, i, base),    accessor.base);
+        CacheRegionPointer(writer, CACHE_FIELD(sparse, ASparseAccessor, i, indices), accessor.indices);
+        CacheRegionPointer(writer, CACHE_FIELD(sparse, ASparseAccessor, i, values),  accessor.values);
+        CacheRegionPointer(writer, CACHE_FIELD(sparse, ASparseAccessor, i, dense),   accessor.dense);
+    }
+
+    uint64_t meshes = CacheAppend(writer, scene->meshes, sizeof(AMesh) * scene->numMeshes);
+    CachePointer(writer, so + offsetof(SceneBundle, meshes), meshes);
+    for (int m = 0; m < scene->numMeshes; m++)
+    {
+        const AMesh& mesh = scene->meshes[m];
+        CachePointer(writer, CACHE_FIELD(meshes, AMesh, m, name), CacheString(writer, mesh.name));
+        if (mesh.primitives == nullptr) continue;
+
+        // primitives is stretchy buffer, keep the capacity and count in front of it so SBCount works
+        int header[2] = { mesh.numPrimitives, mesh.numPrimitives };
+        CacheAppend(writer, header, sizeof(header));
+        uint64_t primitives = CacheAppend(writer, mesh.primitives, sizeof(APrimitive) * mesh.numPrimitives, alignof(int));
+        CachePointer(writer, CACHE_FIELD(meshes, AMesh, m, primitives), primitives);
+
+        for (int p = 0; p < mesh.numPrimitives; p++)
+        {
+            const APrimitive& primitive = mesh.primitives[p];
+            CacheRegionPointer(writer, CACHE_FIELD(primitives, APrimitive, p, indices),  primitive.indices);
+            CacheRegionPointer(writer, CACHE_FIELD(primitives, APrimitive, p, sourceIndices), primitive.sourceIndices);
+            CacheRegionPointer(writer, CACHE_FIELD(primitives, APrimitive, p, vertices), primitive.vertices);
+            for (int j = 0; j < AAttribType_Count; j++)
+            {
+                uint64_t field = CACHE_FIELD(primitives, APrimitive, p, vertexAttribs) + j * sizeof(void*);
+                if (primitive.sparseAttributes & (1u << j))
+                    CachePointer(writer, field, sparse + sizeof(ASparseAccessor) * ((const ASparseAccessor*)primitive.vertexAttribs[j] - scene->sparseAccessors));
+                else
+                    CacheRegionPointer(writer, field, primitive.vertexAttribs[j]);
+            }
+        }
+    }
+
+    uint64_t nodes = CacheAppend(writer, scene->nodes, sizeof(ANode) * scene->numNodes);
+    CachePointer(writer, so + offsetof(SceneBundle, nodes), nodes);
+    for (int i = 0; i < scene->numNodes; i++)
+    {
+        const ANode& node = scene->nodes[i];
+        CachePointer(writer, CACHE_FIELD(nodes, ANode, i, name), CacheString(writer, node.name));
+        uint64_t children = node.numChildren ? CacheAppend(writer, node.children, sizeof(int) * node.numChildren) : 0;
+        CachePointer(writer, CACHE_FIELD(nodes, ANode, i, children), children);
+    }
+
+    uint64_t materials = CacheAppend(writer, scene->materials, sizeof(AMaterial) * scene->numMaterials);
+    CachePointer(writer, so + offsetof(SceneBundle, materials), materials);
+    for (int i = 0; i < scene->numMaterials; i++)
+        CachePointer(writer, CACHE_FIELD(materials, AMaterial, i, name), CacheString(writer, scene->materials[i].name));
+
+    uint64_t textures = CacheAppend(writer, scene->textures, sizeof(ATexture) * scene->numTextures);
+    CachePointer(writer, so + offsetof(SceneBundle, textures), textures);
+    for (int i = 0; i < scene->numTextures; i++)
+        CachePointer(writer, CACHE_FIELD(textures, ATexture, i, name), CacheString(writer, scene->textures[i].name));
+
+    uint64_t images = CacheAppend(writer, scene->images, sizeof(AImage) * scene->numImages);
+    CachePointer(writer, so + offsetof(SceneBundle, images), images);
+    for (int i = 0; i < scene->numImages; i++)
+    {
+        const AImage& image = scene->images[i];
+        int ownsData = 0; // data is in the mapping
+        SmallMemCpy(writer.data.Data() + (CACHE_FIELD(images, AImage, i, ownsData) - writer.base), &ownsData, sizeof(int));
+        CachePointer(writer, CACHE_FIELD(images, AImage, i, path), CacheString(writer, image.path));
+        CachePointer(writer, CACHE_FIELD(images, AImage, i, data), CacheAppend(writer, image.data, image.dataSize));
+    }
+
+    uint64_t samplers = CacheAppend(writer, scene->samplers, sizeof(ASampler) * scene->numSamplers);
+    CachePointer(writer, so + offsetof(SceneBundle, samplers), samplers);
+
+    uint64_t cameras = CacheAppend(writer, scene->cameras, sizeof(ACamera) * scene->numCameras);
+    CachePointer(writer, so + offsetof(SceneBundle, cameras), cameras);
+    for (int i = 0; i < scene->numCameras; i++)
+        CachePointer(writer, CACHE_FIELD(cameras, ACamera, i, name), CacheString(writer, scene->cameras[i].name));
+
+    uint64_t scenes = CacheAppend(writer, scene->scenes, sizeof(AScene) * scene->numScenes);
+    CachePointer(writer, so + offsetof(SceneBundle, scenes), scenes);
+    for (int i = 0; i < scene->numScenes; i++)
+    {
+        const AScene& s = scene->scenes[i];
+        CachePointer(writer, CACHE_FIELD(scenes, AScene, i, name), CacheString(writer, s.name));
+        uint64_t sceneNodes = s.numNodes ? CacheAppend(writer, s.nodes, sizeof(int) * s.numNodes) : 0;
+        CachePointer(writer, CACHE_FIELD(scenes, AScene, i, nodes), sceneNodes);
+    }
+
+    uint64_t buffers = CacheAppend(writer, scene->buffers, sizeof(GLTFBuffer) * scene->numBuffers);
+    CachePointer(writer, so + offsetof(SceneBundle, buffers), buffers);
+    for (int i = 0; i < scene->numBuffers; i++)
+    {
+        GLTFBuffer buffer = scene->buffers[i];
+        if (!writer.inPlace)
+        {
+            buffer.flags      = ABufferFlag_External; // owned by the mapping
+            buffer.mappedSize = 0;
+        }
+        SmallMemCpy(writer.data.Data() + (buffers + sizeof(GLTFBuffer) * i - writer.base), &buffer, sizeof(GLTFBuffer));
+        CacheRegionPointer(writer, CACHE_FIELD(buffers, GLTFBuffer, i, uri), buffer.uri);
+    }
+
+    uint64_t skins = CacheAppend(writer, scene->skins, sizeof(ASkin) * scene->numSkins);
+    CachePointer(writer, so + offsetof(SceneBundle, skins), skins);
+    for (int i = 0; i < scene->numSkins; i++)
+    {
+        const ASkin& skin = scene->skins[i];
+        CachePointer(writer, CACHE_FIELD(skins, ASkin, i, name), CacheString(writer, skin.name));
+        CacheRegionPointer(writer, CACHE_FIELD(skins, ASkin, i, inverseBindMatrices), skin.inverseBindMatrices);
+        uint64_t joints = skin.numJoints ? CacheAppend(writer, skin.joints, sizeof(int) * skin.numJoints) : 0;
+        CachePointer(writer, CACHE_FIELD(skins, ASkin, i, joints), joints);
+    }
+
+    uint64_t animations = CacheAppend(writer, scene->animations, sizeof(AAnimation) * scene->numAnimations);
+    CachePointer(writer, so + offsetof(SceneBundle, animations), animations);
+    for (int a = 0; a < scene->numAnimations; a++)
+    {
+        const AAnimation& animation = scene->animations[a];
+        CachePointer(writer, CACHE_FIELD(animations, AAnimation, a, name), CacheString(writer, animation.name));
+        uint64_t channels = CacheAppend(writer, animation.channels, sizeof(AAnimChannel) * animation.numChannels);
+        CachePointer(writer, CACHE_FIELD(animations, AAnimation, a, channels), channels);
+        
+        uint64_t samplers = CacheAppend(writer, animation.samplers, sizeof(AAnimSampler) * animation.numSamplers);
+        CachePointer(writer, CACHE_FIELD(animations, AAnimation, a, samplers), samplers);
+        for (int s = 0; s < animation.numSamplers; s++)
+        {
+            CacheRegionPointer(writer, CACHE_FIELD(samplers, AAnimSampler, s, input),  animation.samplers[s].input);
+            CacheRegionPointer(writer, CACHE_FIELD(samplers, AAnimSampler, s, output), animation.samplers[s].output);
+        }
+    }
+    return so;
+}
+
+__public int SaveGLTFCache(const SceneBundle* scene, const char* cachePath, const char* sourcePath)
+{
+    ASSERT(scene && cachePath);
+    ACacheHeader header{};
+    header.magic       = ACacheMagic;
+    header.version     = ACacheVersion;
+    header.pointerSize = sizeof(void*);
+    header.bundleSize  = sizeof(SceneBundle);
+    if (sourcePath && !AFileInfo(sourcePath, &header.sourceSize, &header.sourceTime)) return 0;
+    
+    // binary data goes first, so pointer fix up doesn't touch it's pages
+    ACacheWriter writer{};
+    uint64_t offset = sizeof(ACacheHeader);
+    for (int i = 0; i < scene->numBuffers; i++)
+    {
+        ACacheRegion region = { (const char*)scene->buffers[i].uri, (uint64_t)scene->buffers[i].byteLength, 0 };
+        if (region.data == nullptr) continue; // not loaded with selective loading
+        offset = AlignAddress(offset, 16);
+        region.offset = offset;
+        offset += region.size;
+        writer.regions.Add(region);
+    }
+    
+    // dense copies of sparse accessors, skins and animations might point into them
+    for (int i = 0; i < scene->numSparseAccessors; i++)
+    {
+        const ASparseAccessor& sparse = scene->sparseAccessors[i];
+        if (sparse.dense == nullptr) continue;
+        ACacheRegion region = { (const char*)sparse.dense, (uint64_t)ASparseElementSize(&sparse) * sparse.numElements, 0 };
+        offset = AlignAddress(offset, 16);
+        region.offset = offset;
+        offset += region.size;
+        writer.regions.Add(region);
+    }
+    
+    // created with ACreateVerticesIndices, indices are always uint32
+    ACacheRegion packed[2] = { 
+        { (const char*)scene->allVertices, (uint64_t)scene->totalVertices * scene->vertexSize, 0 }, 
+        { (const char*)scene->allIndices,  (uint64_t)scene->totalIndices * sizeof(uint32_t), 0 } 
+    };
+    for (int i = 0; i < 2; i++)
+    {
+        if (packed[i].data == nullptr) continue; // empty regions are kept, so the pointers still resolve
+        offset = AlignAddress(offset, 16);
+        packed[i].offset = offset;
+        offset += packed[i].size;
+        writer.regions.Add(packed[i]);
+    }
+
+    writer.base = AlignAddress(offset, 16);
+    header.sceneOffset = CacheWriteMetadata(writer, scene);
+
+    header.relocOffset = AlignAddress(writer.base + writer.data.Size(), 16);
+    header.numRelocs   = writer.relocs.Size();
+    header.fileSize    = header.relocOffset + header.numRelocs * sizeof(uint64_t);
+
+    AFile file = AFileOpen(cachePath, AOpenFlag_Write);
+    if (!AFileExist(file)) return 0;
+    
+    const char zeros[16] = {};
+    uint64_t written = 0;
+    AFileWrite(&header, sizeof(ACacheHeader), file); written += sizeof(ACacheHeader);
+    for (int i = 0; i < writer.regions.Size(); i++)
+    {
+        const ACacheRegion& region = writer.regions[i];
+        AFileWrite(zeros, region.offset - written, file);
+        AFileWrite(region.data, region.size, file);
+        written = region.offset + region.size;
+    }
+    AFileWrite(zeros, writer.base - written, file);
+    AFileWrite(writer.data.Data(), writer.data.Size(), file); 
+    written = writer.base + writer.data.Size();
+    AFileWrite(zeros, header.relocOffset - written, file);
+    AFileWrite(writer.relocs.Data(), header.numRelocs * sizeof(uint64_t), file);
+    AFileClose(file);
+    return 1;
+}
+
+__public int LoadGLTFCache(const char* cachePath, const char* sourcePath, SceneBundle* scene)
+{
+    ASSERT(scene && cachePath);
+    MemsetZero(scene, sizeof(SceneBundle));
+    ACacheHeader expected{};
+    if (sourcePath && !AFileInfo(sourcePath, &expected.sourceSize, &expected.sourceTime)) return 0;
+
+    uint64_t size = 0;
+    char* base = (char*)AMapFile(cachePath, &size, true);
+    if (base == nullptr) return 0;
+    
+    ACacheHeader header;
+    bool valid = size >= sizeof(ACacheHeader);
+    if (valid) SmallMemCpy(&header, base, sizeof(ACacheHeader));
+
+    valid = valid && header.magic == ACacheMagic && header.version == ACacheVersion;
+    valid = valid && header.pointerSize == sizeof(void*) && header.bundleSize == sizeof(SceneBundle);
+    valid = valid && header.fileSize == size && header.relocOffset + header.numRelocs * sizeof(uint64_t) <= size;
+    valid = valid && header.sceneOffset + sizeof(SceneBundle) <= header.relocOffset;
+    // source file is changed
+    valid = valid && (!sourcePath || (header.sourceSize == expected.sourceSize && header.sourceTime == expected.sourceTime));
+    
+    // relocate pointers in single pass, only metadata pages are touched
+    const uint64_t* relocs = (const uint64_t*)(base + header.relocOffset);
+    for (uint64_t i = 0; valid && i < header.numRelocs; i++)
+    {
+        valid = relocs[i] + sizeof(uintptr_t) <= header.relocOffset;
+        if (valid) *(uintptr_t*)(base + relocs[i]) += (uintptr_t)base;
+    }
+
+    if (!valid) 
+    {
+        AUnmapFile(base, size);
+        return 0;
+    }
+
+    SmallMemCpy(scene, base + header.sceneOffset, sizeof(SceneBundle));
+    scene->cacheMapping = base;
+    scene->cacheSize    = size;
+    return 1;
+}
+
+/*****************************************************************
+*                             Arena                              *
+*****************************************************************/
+
+// moves metadata of the scene (arrays, names, primitives, children...) into one block, the block is written 
+// same as the cache file except pointers into buffers are kept. scattered allocations are freed
+__private void MoveSceneToArena(SceneBundle* scene)
+{
+    ACacheWriter writer{};
+    writer.base    = 0;
+    writer.inPlace = true;
+    uint64_t sceneOffset = CacheWriteMetadata(writer, scene);
+    while (writer.data.Size() & 31) writer.data.Add('\0'); // MemCpy<8> copies 32 bytes at a time
+
+    char* arena = (char*)AllocAligned(writer.data.Size(), 16);
+    MemCpy<8>(arena, writer.data.Data(), writer.data.Size());
+    for (int i = 0; i < writer.relocs.Size(); i++)
+        *(uintptr_t*)(arena + writer.relocs[i]) += (uintptr_t)arena;
+
+    // buffers, glb file and dense copies of sparse accessors are not moved
+    SceneBundle old = *scene;
+    old.numBuffers = 0;
+    old.glbSource  = nullptr;
+    for (int i = 0; i < old.numSparseAccessors; i++)
+        old.sparseAccessors[i].dense = nullptr;
+    FreeGLTF(&old);
+
+    SmallMemCpy(scene, arena + sceneOffset, sizeof(SceneBundle));
+    scene->arena = arena;
+}
+
+/*****************************************************************
+*                         Vertex Packing                         *
+*****************************************************************/
+
+// each attribute is packed for all vertices of the primitive at once, so loops doesn't have branches for missing attributes.
+// simd loops convert 4 (sse, neon) or 8 (avx2) vertices and scatter the 32 bit results with destination stride.
+// float3 rows are read with 16 byte loads, simd loops stop before the last vertex so we don't read after the buffer
+
+// round to nearest even like cvtps_epi32 does, valid for |x| < 2^22
+inline int RoundToInt(float x) { return (int)((x + 12582912.0f) - 12582912.0f); }
+
+// same as min_ps and max_ps, nan becomes max
+inline float ClampSimd(float x, float lo, float hi) { x = x < hi ? x : hi; return x > lo ? x : lo; }
+
+// scalar and simd results must be same, x * 511 is written as x * 512 - x because 
+// compiler can fuse the multiply with the rounding add, x * 512 is exact so fused or not result is same
+inline uint32_t Snorm10(float x) { x = ClampSimd(x, -1.0f, 1.0f); return (uint32_t)RoundToInt(x * 512.0f - x) & 0x3FFu; }
+
+// INT_2_10_10_10_REV, w is only used for tangents
+inline uint32_t PackSnorm10(const float* v, int numComponents)
+{
+    uint32_t w = numComponents == 4 ? (uint32_t)RoundToInt(ClampSimd(v[3], -1.0f, 1.0f)) & 3u : 0u;
+    return Snorm10(v[0]) | (Snorm10(v[1]) << 10) | (Snorm10(v[2]) << 20) | (w << 30);
+}
+
+// round to nearest even, denormals, inf and nan are handled. Fabian Giesen's float_to_half_fast3_rtne
+inline uint32_t FloatToHalf(float value)
+{
+    uint32_t f = BitCast<uint32_t>(value);
+    uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+    uint32_t h;
+    if (f >= 0x47800000u) // too big for half, inf or nan
+        h = f > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    else if (f < 0x38800000u) // denormal or zero, 0.5f magic shifts mantissa with rounding
+        h = BitCast<uint32_t>(BitCast<float>(f) + 0.5f) - 0x3F000000u;
+    else
+        h = (f + 0xC8000FFFu + ((f >> 13) & 1u)) >> 13; // rebias exponent, round to nearest even
+    return h | (sign >> 16);
+}
+
+inline uint32_t PackHalf2(const float* v) { return FloatToHalf(v[0]) | (FloatToHalf(v[1]) << 16); }
+
+inline uint32_t PackUnorm8(float x) { x = ClampSimd(x, 0.0f, 1.0f); return (uint32_t)RoundToInt(x * 256.0f - x); }
+
+#if defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+// x y z w of 4 vertices
+inline void LoadRows4(const char* src, int stride, __m128 out[4])
+{
+    out[0] = _mm_loadu_ps((const float*)(src));
+    out[1] = _mm_loadu_ps((const float*)(src + stride));
+    out[2] = _mm_loadu_ps((const float*)(src + stride * 2));
+    out[3] = _mm_loadu_ps((const float*)(src + stride * 3));
+    _MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+}
+
+inline __m128i Snorm10SSE(__m128 x, int shift)
+{
+    x = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+    __m128i i = _mm_and_si128(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(511.0f))), _mm_set1_epi32(0x3FF));
+    return _mm_slli_epi32(i, shift);
+}
+
+// Fabian Giesen's float_to_half_SSE2, halfs are in the low 16 bits (sign extended)
+inline __m128i FloatToHalfSSE(__m128 f)
+{
+    const __m128i subnormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    __m128  justSign  = _mm_and_ps(f, _mm_castsi128_ps(_mm_set1_epi32(0x80000000)));
+    __m128  absf      = _mm_xor_ps(f, justSign);
+    __m128i absi      = _mm_castps_si128(absf);
+    __m128i isNan     = _mm_castps_si128(_mm_cmpunord_ps(absf, absf));
+    __m128i isRegular = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absi);
+    __m128i infOrNan  = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+    __m128i isSub     = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), absi);
+    
+    __m128i subnorm   = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(subnormMagic))), subnormMagic);
+    __m128i mantOdd   = _mm_srai_epi32(_mm_slli_epi32(absi, 31 - 13), 31);
+    __m128i rounded   = _mm_sub_epi32(_mm_add_epi32(absi, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), mantOdd);
+    __m128i normal    = _mm_srli_epi32(rounded, 13);
+    
+    __m128i nonSpecial = _mm_or_si128(_mm_and_si128(subnorm, isSub), _mm_andnot_si128(isSub, normal));
+    __m128i joined     = _mm_or_si128(_mm_and_si128(nonSpecial, isRegular), _mm_andnot_si128(isRegular, infOrNan));
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16));
+}
+
+inline __m128i LoadTwo64(const char* a, const char* b)
+{
+    return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)a), _mm_loadl_epi64((const __m128i*)b));
+}
+#endif
+
+#if defined(AX_SUPPORT_AVX2)
+// x y z w of 8 vertices, lower lanes are first 4 vertices
+inline void LoadRows8(const char* src, int stride, __m256 out[4])
+{
+    __m256 r[4];
+    for (int k = 0; k < 4; k++)
+        r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)(src + stride * k))),
+                                    _mm_loadu_ps((const float*)(src + stride * (k + 4))), 1);
+    __m256d t0 = _mm256_castps_pd(_mm256_unpacklo_ps(r[0], r[1])); // x0 x1 y0 y1
+    __m256d t1 = _mm256_castps_pd(_mm256_unpackhi_ps(r[0], r[1])); // z0 z1 w0 w1
+    __m256d t2 = _mm256_castps_pd(_mm256_unpacklo_ps(r[2], r[3])); // x2 x3 y2 y3
+    __m256d t3 = _mm256_castps_pd(_mm256_unpackhi_ps(r[2], r[3])); // z2 z3 w2 w3
+    out[0] = _mm256_castpd_ps(_mm256_unpacklo_pd(t0, t2));
+    out[1] = _mm256_castpd_ps(_mm256_unpackhi_pd(t0, t2));
+    out[2] = _mm256_castpd_ps(_mm256_unpacklo_pd(t1, t3));
+    out[3] = _mm256_castpd_ps(_mm256_unpackhi_pd(t1, t3));
+}
+
+inline __m256i Snorm10AVX(__m256 x, int shift)
+{
+    x = _mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(1.0f)), _mm256_set1_ps(-1.0f));
+    __m256i i = _mm256_and_si256(_mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(511.0f))), _mm256_set1_epi32(0x3FF));
+    return _mm256_slli_epi32(i, shift);
+}
+
+inline __m256i FloatToHalfAVX(__m256 f)
+{
+    const __m256i subnormMagic = _mm256_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    __m256  justSign  = _mm256_and_ps(f, _mm256_castsi256_ps(_mm256_set1_epi32(0x80000000)));
+    __m256  absf      = _mm256_xor_ps(f, justSign);
+    __m256i absi      = _mm256_castps_si256(absf);
+    __m256i isNan     = _mm256_castps_si256(_mm256_cmp_ps(absf, absf, _CMP_UNORD_Q));
+    __m256i isRegular = _mm256_cmpgt_epi32(_mm256_set1_epi32((127 + 16) << 23), absi);
+    __m256i infOrNan  = _mm256_or_si256(_mm256_and_si256(isNan, _mm256_set1_epi32(0x200)), _mm256_set1_epi32(0x7C00));
+    __m256i isSub     = _mm256_cmpgt_epi32(_mm256_set1_epi32((127 - 14) << 23), absi);
+    
+    __m256i subnorm   = _mm256_sub_epi32(_mm256_castps_si256(_mm256_add_ps(absf, _mm256_castsi256_ps(subnormMagic))), subnormMagic);
+    __m256i mantOdd   = _mm256_srai_epi32(_mm256_slli_epi32(absi, 31 - 13), 31);
+    __m256i rounded   = _mm256_sub_epi32(_mm256_add_epi32(absi, _mm256_set1_epi32(0xFFF - ((127 - 15) << 23))), mantOdd);
+    __m256i normal    = _mm256_srli_epi32(rounded, 13);
+    
+    __m256i nonSpecial = _mm256_or_si256(_mm256_and_si256(subnorm, isSub), _mm256_andnot_si256(isSub, normal));
+    __m256i joined     = _mm256_or_si256(_mm256_and_si256(nonSpecial, isRegular), _mm256_andnot_si256(isRegular, infOrNan));
+    return _mm256_or_si256(joined, _mm256_srai_epi32(_mm256_castps_si256(justSign), 16));
+}
+
+// 8 byte rows of 4 vertices
+inline __m256i LoadFour64(const char* src, int stride)
+{
+    return _mm256_setr_epi64x(UnalignedLoad64(src), UnalignedLoad64(src + stride), 
+                              UnalignedLoad64(src + stride * 2), UnalignedLoad64(src + stride * 3));
+}
+#endif
+
+#if defined(AX_ARM) && defined(__aarch64__)
+inline void LoadRows4(const char* src, int stride, float32x4_t out[4])
+{
+    float32x4x2_t p01 = vtrnq_f32(vld1q_f32((const float*)src), vld1q_f32((const float*)(src + stride)));
+    float32x4x2_t p23 = vtrnq_f32(vld1q_f32((const float*)(src + stride * 2)), vld1q_f32((const float*)(src + stride * 3)));
+    out[0] = vcombine_f32(vget_low_f32(p01.val[0]),  vget_low_f32(p23.val[0]));
+    out[1] = vcombine_f32(vget_low_f32(p01.val[1]),  vget_low_f32(p23.val[1]));
+    out[2] = vcombine_f32(vget_high_f32(p01.val[0]), vget_high_f32(p23.val[0]));
+    out[3] = vcombine_f32(vget_high_f32(p01.val[1]), vget_high_f32(p23.val[1]));
+}
+
+inline uint32x4_t Snorm10Neon(float32x4_t x, float scale)
+{
+    x = vmaxq_f32(vminq_f32(x, vdupq_n_f32(1.0f)), vdupq_n_f32(-1.0f));
+    return vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_n_f32(x, scale)));
+}
+#endif
+
+// stores results of simd loops
+inline void ScatterU32(char* dst, int stride, const uint32_t* values, int count)
+{
+    for (int k = 0; k < count; k++)
+        *(uint32_t*)(dst + stride * k) = values[k];
+}
+
+__private void PackFloats(char* dst, int dstStride, const char* src, int srcStride, int count, int numComponents)
+{
+    int size = numComponents * sizeof(float);
+    for (int i = 0; i < count; i++)
+        SmallMemCpy(dst + (int64_t)i * dstStride, src + (int64_t)i * srcStride, size);
+}
+
+// numComponents is 3 for normals and 4 for tangents
+template<int numComponents>
+__private void PackNormals(char* dst, int dstStride, const char* src, int srcStride, int count)
+{
+    int i = 0;
+#if defined(AX_SUPPORT_AVX2)
+    alignas(32) uint32_t packed[8];
+    for (; i + 8 < count; i += 8)
+    {
+        __m256 v[4];
+        LoadRows8(src + (int64_t)i * srcStride, srcStride, v);
+        __m256i r = _mm256_or_si256(Snorm10AVX(v[0], 0), _mm256_or_si256(Snorm10AVX(v[1], 10), Snorm10AVX(v[2], 20)));
+        if_constexpr (numComponents == 4)
+        {
+            __m256 w = _mm256_max_ps(_mm256_min_ps(v[3], _mm256_set1_ps(1.0f)), _mm256_set1_ps(-1.0f));
+            r = _mm256_or_si256(r, _mm256_slli_epi32(_mm256_cvtps_epi32(w), 30));
+        }
+        _mm256_store_si256((__m256i*)packed, r);
+        ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 8);
+    }
+#elif defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+    alignas(16) uint32_t packed[4];
+    for (; i + 4 < count; i += 4)
+    {
+        __m128 v[4];
+        LoadRows4(src + (int64_t)i * srcStride, srcStride, v);
+        __m128i r = _mm_or_si128(Snorm10SSE(v[0], 0), _mm_or_si128(Snorm10SSE(v[1], 10), Snorm10SSE(v[2], 20)));
+        if_constexpr (numComponents == 4)
+        {
+            __m128 w = _mm_max_ps(_mm_min_ps(v[3], _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+            r = _mm_or_si128(r, _mm_slli_epi32(_mm_cvtps_epi32(w), 30));
+        }
+        _mm_store_si128((__m128i*)packed, r);
+        ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
+    }
+#elif defined(AX_ARM) && defined(__aarch64__)
+    alignas(16) uint32_t packed[4];
+    for (; i + 4 < count; i += 4)
+    {
+        float32x4_t v[4];
+        LoadRows4(src + (int64_t)i * srcStride, srcStride, v);
+        uint32x4_t mask = vdupq_n_u32(0x3FF);
+        uint32x4_t r = vandq_u32(Snorm10Neon(v[0], 511.0f), mask);
+        r = vorrq_u32(r, vshlq_n_u32(vandq_u32(Snorm10Neon(v[1], 511.0f), mask), 10));
+        r = vorrq_u32(r, vshlq_n_u32(vandq_u32(Snorm10Neon(v[2], 511.0f), mask), 20));
+        if_constexpr (numComponents == 4)
+            r = vorrq_u32(r, vshlq_n_u32(Snorm10Neon(v[3], 1.0f), 30));
+        vst1q_u32(packed, r);
+        ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
+    }
+#endif
+    for (; i < count; i++)
+        *(uint32_t*)(dst + (int64_t)i * dstStride) = PackSnorm10((const float*)(src + (int64_t)i * srcStride), numComponents);
+}
+
+// float2 to half2
+__private void PackTexCoords(char* dst, int dstStride, const char* src, int srcStride, int count)
+{
+    int i = 0;
+#if defined(AX_SUPPORT_AVX2)
+    alignas(32) uint32_t packed[8];
+    for (; i + 8 <= count; i += 8)
+    {
+        const char* s = src + (int64_t)i * srcStride;
+        __m256i a = FloatToHalfAVX(_mm256_castsi256_ps(LoadFour64(s, srcStride)));
+        __m256i b = FloatToHalfAVX(_mm256_castsi256_ps(LoadFour64(s + srcStride * 4, srcStride)));
+        // packs works in lanes: v0 v1 v4 v5 | v2 v3 v6 v7
+        __m256i r = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8); // 0, 2, 1, 3
+        _mm256_store_si256((__m256i*)packed, r);
+        ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 8);
+    }
+#elif defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+    alignas(16) uint32_t packed[4];
+    for (; i + 4 <= count; i += 4)
+    {
+        const char* s = src + (int64_t)i * srcStride;
+        __m128i a = FloatToHalfSSE(_mm_castsi128_ps(LoadTwo64(s, s + srcStride)));
+        __m128i b = FloatToHalfSSE(_mm_castsi128_ps(LoadTwo64(s + srcStride * 2, s + srcStride * 3)));
+        _mm_store_si128((__m128i*)packed, _mm_packs_epi32(a, b)); // halfs are sign extended, packs doesn't saturate them
+        ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
+    }
+#elif defined(AX_ARM) && defined(__aarch64__)
+    alignas(16) uint32_t packed[4];
+    for (; i + 4 <= count; i += 4)
+    {
+        const char* s = src + (int64_t)i * srcStride;
+        float32x4_t a = vcombine_f32(vld1_f32((const float*)s), vld1_f32((const float*)(s + srcStride)));
+        float32x4_t b = vcombine_f32(vld1_f32((const float*)(s + srcStride * 2)), vld1_f32((const float*)(s + srcStride * 3)));
+        float16x8_t h = vcombine_f16(vcvt_f16_f32(a), vcvt_f16_f32(b));
+        vst1q_u32(packed, vreinterpretq_u32_f16(h));
+        ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
+    }
+#endif
+    for (; i < count; i++)
+        *(uint32_t*)(dst + (int64_t)i * dstStride) = PackHalf2((const float*)(src + (int64_t)i * srcStride));
+}
+
+// joint indices to 4 x uint8, type is GL_UNSIGNED_BYTE or GL_UNSIGNED_SHORT
+__private void PackJoints(char* dst, int dstStride, const char* src, int srcStride, int count, int type, int numJoints)
 {
-    char text[64]{};
-    curr += sizeof("meshes'"); // skip meshes" 
-    AMesh mesh{};
-    MemsetZero(&mesh, sizeof(AMesh));
-
-    // parse all meshes
-    while (true)
+    int size = AComponentSizes[type];
+    if (srcStride == 0) srcStride = size * numJoints;
+    int i = 0;
+    // packus saturates as signed 16 bit, joints are clamped to 255 before it like the scalar loop does
+    if (type == 3 && numJoints == 4) // rgba16u
     {
-        while (*curr != '"')
+    #if defined(AX_SUPPORT_AVX2)
+        alignas(32) uint32_t packed[8];
+        const __m256i maxJoint = _mm256_set1_epi16(255);
+        for (; i + 8 <= count; i += 8)
         {
-            if (*curr == '}') 
-            {
-                meshes.Add(mesh);
-                MemsetZero(&mesh, sizeof(AMesh));
-            }
-            if (*curr++ == ']') return curr; // end of meshes
-        }
-        curr = GetStringInQuotes(text, curr);
-        
-        if (StrCMP16(text, "name")) {
-            curr = CopyStringInQuotes(mesh.name, curr, stringAllocator); 
-            continue; 
+            const char* s = src + (int64_t)i * srcStride;
+            __m256i a = _mm256_min_epu16(LoadFour64(s, srcStride), maxJoint);
+            __m256i b = _mm256_min_epu16(LoadFour64(s + srcStride * 4, srcStride), maxJoint);
+            __m256i r = _mm256_packus_epi16(a, b);
+            _mm256_store_si256((__m256i*)packed, _mm256_permute4x64_epi64(r, 0xD8));
+            ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 8);
         }
-        else if (!StrCMP16(text, "primitives")) { 
-            ASSERT(0 && "only primitives and name allowed"); 
-            return (const char*)AError_UNKNOWN_MESH_VAR; 
+    #elif defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+        alignas(16) uint32_t packed[4];
+        const __m128i maxJoint = _mm_set1_epi16(255);
+        for (; i + 4 <= count; i += 4)
+        {
+            const char* s = src + (int64_t)i * srcStride;
+            __m128i a = LoadTwo64(s, s + srcStride), b = LoadTwo64(s + srcStride * 2, s + srcStride * 3);
+            // sse2 doesn't have min_epu16, x - max(x - 255, 0) is min(x, 255)
+            a = _mm_subs_epu16(a, _mm_subs_epu16(a, maxJoint));
+            b = _mm_subs_epu16(b, _mm_subs_epu16(b, maxJoint));
+            __m128i r = _mm_packus_epi16(a, b);
+            _mm_store_si128((__m128i*)packed, r);
+            ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
         }
-
-        APrimitive primitive{};  
-        primitive.material = -1;
-        // parse primitives
-        while (true)
+    #elif defined(AX_ARM) && defined(__aarch64__)
+        alignas(16) uint32_t packed[4];
+        for (; i + 4 <= count; i += 4)
         {
-            while (*curr != '"')
-            {
-                if (*curr == '}')
-                {
-                    SBPush(mesh.primitives, primitive);
-                    MemsetZero(&primitive, sizeof(APrimitive));
-                    mesh.numPrimitives++;
-                    primitive.material = -1;
-                }
-
-                if (*curr++ == ']') goto end_primitives; // this is end of primitive list
-            }
-            curr++;
-            
-            if      (StrCMP16(curr, "attributes")) { curr = ParseAttributes(curr, &primitive); }
-            else if (StrCMP16(curr, "indices"))    { primitive.indiceIndex = ParsePositiveNumber(curr); }
-            else if (StrCMP16(curr, "mode"))       { primitive.mode        = ParsePositiveNumber(curr); }
-            else if (StrCMP16(curr, "material"))   { primitive.material    = ParsePositiveNumber(curr); }
-            else { ASSERT(0); return (const char*)AError_UNKNOWN_MESH_PRIMITIVE_VAR; }
+            const char* s = src + (int64_t)i * srcStride;
+            uint16x8_t a = vcombine_u16(vld1_u16((const uint16_t*)s), vld1_u16((const uint16_t*)(s + srcStride)));
+            uint16x8_t b = vcombine_u16(vld1_u16((const uint16_t*)(s + srcStride * 2)), vld1_u16((const uint16_t*)(s + srcStride * 3)));
+            vst1q_u32(packed, vreinterpretq_u32_u8(vcombine_u8(vqmovn_u16(a), vqmovn_u16(b))));
+            ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
         }
-        end_primitives:{}
-        curr++; // skip ]
+    #endif
     }
-    return nullptr;
-}
-
-struct IntPtrPair { int numElements, *ptr; };
 
-static IntPtrPair ParseIntArray(const char*& cr, AIntAllocator& intAllocator)
-{
-    const char* curr = cr;
-    IntPtrPair result={};
-    // find how many elements there are:
-    while (!IsNumber(*curr)) curr++;
-    
-    const char* begin = curr;
-    result.numElements = 1;
-    while (true)
-    {
-        result.numElements += *curr == ',';
-        if (*curr++ == ']') break;
-    }
-    curr = begin;
-    result.ptr = intAllocator.AllocateUninitialized(result.numElements);
-    result.numElements = 0;
-    
-    while (*curr != ']')
+    for (; i < count; i++)
     {
-        if (IsNumber(*curr))
+        const char* s = src + (int64_t)i * srcStride;
+        uint32_t joints = 0;
+        for (int k = 0; k < numJoints && k < 4; k++)
         {
-            result.ptr[result.numElements] = ParsePositiveNumber(curr);
-            result.numElements++;
+            uint32_t joint = size == 1 ? (uint8_t)s[k] : ((const uint16_t*)s)[k];
+            ASSERT(joint < 256u && "joint index has to be smaller than 256");
+            joints |= MIN(joint, 255u) << (k * 8);
         }
-        curr++;
+        *(uint32_t*)(dst + (int64_t)i * dstStride) = joints;
     }
-    cr = curr;
-    return result;
 }
 
-__private const char* ParseNodes(const char* curr,
-                                 Array<ANode>& nodes,
-                                 AStringAllocator& stringAllocator,
-                                 FixedSizeGrowableAllocator<int>& intAllocator, float scale)
+// weights to 4 x unorm8, type is GL_FLOAT, GL_UNSIGNED_BYTE or GL_UNSIGNED_SHORT
+__private void PackWeights(char* dst, int dstStride, const char* src, int srcStride, int count, int type, int numWeights)
 {
-    curr = SkipUntill(curr, '[');
-    curr++;
-    ANode node{};
-    node.rotation[3] = 1.0f;
-    node.scale[0] = node.scale[1] = node.scale[2] = scale; 
-    node.index = -1;
-    
-    // read each node
-    while (true)
+    int size = AComponentSizes[type];
+    if (srcStride == 0) srcStride = size * numWeights;
+    int i = 0;
+    if (type == 6 && numWeights == 4) // rgba32f
     {
-        // search for name
-        while (*curr && *curr != '"')
+    #if defined(AX_SUPPORT_AVX2)
+        alignas(32) uint32_t packed[8];
+        for (; i + 8 <= count; i += 8)
         {
-            if (*curr == '}')
+            const char* s = src + (int64_t)i * srcStride;
+            __m256i r[4];
+            for (int k = 0; k < 4; k++)
             {
-                nodes.Add(node);
-                MemsetZero(&node, sizeof(ANode));
-                node.rotation[3] = 1.0f;
-                node.scale[0] = node.scale[1] = node.scale[2] = scale;
-                node.index = -1;
+                __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((const float*)(s + srcStride * k))),
+                                                _mm_loadu_ps((const float*)(s + srcStride * (k + 4))), 1);
+                w = _mm256_max_ps(_mm256_min_ps(w, _mm256_set1_ps(1.0f)), _mm256_setzero_ps());
+                r[k] = _mm256_cvtps_epi32(_mm256_mul_ps(w, _mm256_set1_ps(255.0f)));
             }
-            if (*curr++ == ']') return curr; // end all nodes
+            // rows are v0 v4, v1 v5.. after packs vertices are in order
+            __m256i bytes = _mm256_packus_epi16(_mm256_packs_epi32(r[0], r[1]), _mm256_packs_epi32(r[2], r[3]));
+            _mm256_store_si256((__m256i*)packed, bytes);
+            ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 8);
         }
-        ASSERT(*curr != '\0' && "parsing nodes not possible, probably forgot to close brackets!");
-        curr++; // skips the "
-        
-        // mesh, name, children, matrix, translation, rotation, scale
-        if      (StrCMP16(curr, "mesh"))   { node.type = 0; node.index = ParsePositiveNumber(curr); continue; } // don't want to skip ] that's why continue
-        else if (StrCMP16(curr, "camera")) { node.type = 1; node.index = ParsePositiveNumber(curr); continue; } // don't want to skip ] that's why continue
-        else if (StrCMP16(curr, "children"))
+    #elif defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+        alignas(16) uint32_t packed[4];
+        for (; i + 4 <= count; i += 4)
         {
-            IntPtrPair result = ParseIntArray(curr, intAllocator);
-            node.numChildren = result.numElements;
-            node.children = result.ptr;
+            const char* s = src + (int64_t)i * srcStride;
+            __m128i r[4];
+            for (int k = 0; k < 4; k++)
+            {
+                __m128 w = _mm_max_ps(_mm_min_ps(_mm_loadu_ps((const float*)(s + srcStride * k)), _mm_set1_ps(1.0f)), _mm_setzero_ps());
+                r[k] = _mm_cvtps_epi32(_mm_mul_ps(w, _mm_set1_ps(255.0f)));
+            }
+            _mm_store_si128((__m128i*)packed, _mm_packus_epi16(_mm_packs_epi32(r[0], r[1]), _mm_packs_epi32(r[2], r[3])));
+            ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
         }
-        else if (StrCMP16(curr, "matrix"))
+    #elif defined(AX_ARM) && defined(__aarch64__)
+        alignas(16) uint32_t packed[4];
+        for (; i + 4 <= count; i += 4)
         {
-            Matrix4 m;
-            float* matrix = (float*)&m;
-            
-            for (int i = 0; i < 16; i++)
-                matrix[i] = ParseFloat(curr);
-            
-            m = Matrix4::Transpose(m);
-            node.translation[0] = matrix[12];
-            node.translation[1] = matrix[13];
-            node.translation[2] = matrix[14];
-            QuaternionFromMatrix(node.rotation, matrix);
+            const char* s = src + (int64_t)i * srcStride;
+            uint16x4_t r[4];
+            for (int k = 0; k < 4; k++)
+            {
+                float32x4_t w = vmaxq_f32(vminq_f32(vld1q_f32((const float*)(s + srcStride * k)), vdupq_n_f32(1.0f)), vdupq_n_f32(0.0f));
+                r[k] = vqmovn_u32(vcvtnq_u32_f32(vmulq_n_f32(w, 255.0f)));
+            }
+            uint8x16_t bytes = vcombine_u8(vqmovn_u16(vcombine_u16(r[0], r[1])), vqmovn_u16(vcombine_u16(r[2], r[3])));
+            vst1q_u32(packed, vreinterpretq_u32_u8(bytes));
+            ScatterU32(dst + (int64_t)i * dstStride, dstStride, packed, 4);
+        }
+    #endif
+    }
 
-            vec_t v = VecMulf(Matrix4::ExtractScaleV(m), scale);
-            Vec3Store(node.scale, v);
+    for (; i < count; i++)
+    {
+        const char* s = src + (int64_t)i * srcStride;
+        uint32_t weights = 0;
+        for (int k = 0; k < numWeights && k < 4; k++)
+        {
+            uint32_t weight;
+            if (type == 6)      weight = PackUnorm8(((const float*)s)[k]);
+            else if (size == 2) weight = (((const uint16_t*)s)[k] * 255u + 32767u) / 65535u;
+            else                weight = (uint8_t)s[k];
+            weights |= weight << (k * 8);
         }
-        else if (StrCMP16(curr, "translation"))
+        *(uint32_t*)(dst + (int64_t)i * dstStride) = weights;
+    }
+}
+
+__private void ZeroAttribute(char* dst, int dstStride, int count)
+{
+    for (int i = 0; i < count; i++)
+        *(uint32_t*)(dst + (int64_t)i * dstStride) = 0u;
+}
+
+// indices + base to uint32, 16 indices per iteration. 8 and 16 bit indices are zero extended with unpacks
+__private void RebaseIndices32(uint32_t* dst, const char* src, int srcType, int count, uint32_t base)
+{
+    int i = 0;
+#if defined(AX_SUPPORT_AVX2)
+    __m256i vbase = _mm256_set1_epi32(base);
+    switch (srcType)
+    {
+        case 1:
+        for (; i + 16 <= count; i += 16)
         {
-            node.translation[0] = ParseFloat(curr);
-            node.translation[1] = ParseFloat(curr);
-            node.translation[2] = ParseFloat(curr);
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            _mm256_storeu_si256((__m256i*)(dst + i),     _mm256_add_epi32(_mm256_cvtepu8_epi32(v), vbase));
+            _mm256_storeu_si256((__m256i*)(dst + i + 8), _mm256_add_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)), vbase));
         }
-        else if (StrCMP16(curr, "rotation"))
+        break;
+        case 3:
+        for (; i + 16 <= count; i += 16)
         {
-            node.rotation[0] = ParseFloat(curr);
-            node.rotation[1] = ParseFloat(curr);
-            node.rotation[2] = ParseFloat(curr);
-            node.rotation[3] = ParseFloat(curr);
+            __m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 2));
+            _mm256_storeu_si256((__m256i*)(dst + i),     _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)), vbase));
+            _mm256_storeu_si256((__m256i*)(dst + i + 8), _mm256_add_epi32(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)), vbase));
         }
-        else if (StrCMP16(curr, "scale"))
+        break;
+        default:
+        for (; i + 16 <= count; i += 16)
         {
-            node.scale[0] = ParseFloat(curr) * scale;
-            node.scale[1] = ParseFloat(curr) * scale;
-            node.scale[2] = ParseFloat(curr) * scale;
+            _mm256_storeu_si256((__m256i*)(dst + i),     _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(src + i * 4)), vbase));
+            _mm256_storeu_si256((__m256i*)(dst + i + 8), _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(src + i * 4 + 32)), vbase));
         }
-        else if (StrCMP16(curr, "name"))
+        break;
+    }
+#elif defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+    __m128i vbase = _mm_set1_epi32(base), zero = _mm_setzero_si128();
+    switch (srcType)
+    {
+        case 1:
+        for (; i + 16 <= count; i += 16)
         {
-            curr = CopyStringInQuotes(node.name, curr + 5, stringAllocator);
-            continue; 
+            __m128i v  = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+            _mm_storeu_si128((__m128i*)(dst + i),      _mm_add_epi32(_mm_unpacklo_epi16(lo, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 4),  _mm_add_epi32(_mm_unpackhi_epi16(lo, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 8),  _mm_add_epi32(_mm_unpacklo_epi16(hi, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 12), _mm_add_epi32(_mm_unpackhi_epi16(hi, zero), vbase));
         }
-        else if (StrCMP16(curr, "skin"))
+        break;
+        case 3:
+        for (; i + 16 <= count; i += 16)
         {
-            node.skin = ParsePositiveNumber(curr);
-            continue; // continue because we don't want to skip ] and it is not exist
+            __m128i a = _mm_loadu_si128((const __m128i*)(src + i * 2));
+            __m128i b = _mm_loadu_si128((const __m128i*)(src + i * 2 + 16));
+            _mm_storeu_si128((__m128i*)(dst + i),      _mm_add_epi32(_mm_unpacklo_epi16(a, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 4),  _mm_add_epi32(_mm_unpackhi_epi16(a, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 8),  _mm_add_epi32(_mm_unpacklo_epi16(b, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 12), _mm_add_epi32(_mm_unpackhi_epi16(b, zero), vbase));
         }
-        else
+        break;
+        default:
+        for (; i + 16 <= count; i += 16)
+            for (int k = 0; k < 16; k += 4)
+                _mm_storeu_si128((__m128i*)(dst + i + k), _mm_add_epi32(_mm_loadu_si128((const __m128i*)(src + (i + k) * 4)), vbase));
+        break;
+    }
+#elif defined(AX_ARM)
+    uint32x4_t vbase = vdupq_n_u32(base);
+    switch (srcType)
+    {
+        case 1:
+        for (; i + 16 <= count; i += 16)
         {
-            ASSERT(0 && "Unknown node variable");
-            return (const char*)AError_UNKNOWN_NODE_VAR;
+            uint8x16_t v = vld1q_u8((const uint8_t*)(src + i));
+            uint16x8_t lo = vmovl_u8(vget_low_u8(v)), hi = vmovl_u8(vget_high_u8(v));
+            vst1q_u32(dst + i,      vaddw_u16(vbase, vget_low_u16(lo)));
+            vst1q_u32(dst + i + 4,  vaddw_u16(vbase, vget_high_u16(lo)));
+            vst1q_u32(dst + i + 8,  vaddw_u16(vbase, vget_low_u16(hi)));
+            vst1q_u32(dst + i + 12, vaddw_u16(vbase, vget_high_u16(hi)));
         }
-
-        curr = SkipUntill(curr, ']');
-        curr++;
+        break;
+        case 3:
+        for (; i + 16 <= count; i += 16)
+        {
+            uint16x8_t a = vld1q_u16((const uint16_t*)(src + i * 2));
+            uint16x8_t b = vld1q_u16((const uint16_t*)(src + i * 2 + 16));
+            vst1q_u32(dst + i,      vaddw_u16(vbase, vget_low_u16(a)));
+            vst1q_u32(dst + i + 4,  vaddw_u16(vbase, vget_high_u16(a)));
+            vst1q_u32(dst + i + 8,  vaddw_u16(vbase, vget_low_u16(b)));
+            vst1q_u32(dst + i + 12, vaddw_u16(vbase, vget_high_u16(b)));
+        }
+        break;
+        default:
+        for (; i + 16 <= count; i += 16)
+            for (int k = 0; k < 16; k += 4)
+                vst1q_u32(dst + i + k, vaddq_u32(vld1q_u32((const uint32_t*)(src + (i + k) * 4)), vbase));
+        break;
+    }
+#endif
+    switch (srcType)
+    {
+        case 1:  for (; i < count; i++) dst[i] = ((const uint8_t*)src)[i]  + base; break;
+        case 3:  for (; i < count; i++) dst[i] = ((const uint16_t*)src)[i] + base; break;
+        default: for (; i < count; i++) dst[i] = ((const uint32_t*)src)[i] + base; break;
     }
-    return nullptr;
 }
 
-__private const char* ParseCameras(const char* curr, Array<ACamera>& cameras, AStringAllocator& stringAllocator)
+// indices + base to uint16, results has to fit into 16 bit so additions can wrap in 16 bit lanes
+__private void RebaseIndices16(uint16_t* dst, const char* src, int srcType, int count, uint32_t base)
 {
-    curr += sizeof("camera'");
-    char text[64]{};
-    ACamera camera{};
-    // parse all meshes
-    while (true)
+    int i = 0;
+#if defined(AX_SUPPORT_AVX2)
+    __m256i vbase = _mm256_set1_epi16((short)base);
+    switch (srcType)
     {
-        while (*curr != '"')
+        case 1:
+        for (; i + 16 <= count; i += 16)
         {
-            if (*curr == '}') 
-            {
-                cameras.Add(camera);
-                MemsetZero(&camera, sizeof(ACamera));
-            }
-            if (*curr++ == ']') return curr; // end of cameras
-        }
-        curr = GetStringInQuotes(text, curr);
-        
-        if (StrCMP16(text, "name")) {
-            curr = CopyStringInQuotes(camera.name, curr, stringAllocator); 
-            continue; 
-        }
-        if (StrCMP16(text, "type")) {
-            curr = SkipUntill(curr, '"');
-            curr++;
-            camera.type = *curr == 'p'; // 0 orthographic 1 perspective 
-            curr = SkipUntill(curr, '"');
-            curr++;
-            continue; 
+            __m256i v = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + i)));
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi16(v, vbase));
         }
-        else if (!StrCMP16(text, "orthographic") && !StrCMP16(text, "perspective")) { 
-            ASSERT(0 && "unknown camera variable"); 
-            return (const char*)AError_UNKNOWN_CAMERA_VAR; 
-        }
-
-        // parse primitives
-        while (true)
+        break;
+        case 3:
+        for (; i + 16 <= count; i += 16)
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi16(_mm256_loadu_si256((const __m256i*)(src + i * 2)), vbase));
+        break;
+        default:
+        for (; i + 16 <= count; i += 16)
         {
-            while (*curr != '"')
-            if (*curr++ == '}')  goto end_properties; // this is end of camera variables
-            
-            curr++;
-            if      (StrCMP16(curr, "zfar"))        { camera.zFar        = ParseFloat(curr); }
-            else if (StrCMP16(curr, "znear"))       { camera.zNear       = ParseFloat(curr); }
-            else if (StrCMP16(curr, "aspectRatio")) { camera.aspectRatio = ParseFloat(curr); }
-            else if (StrCMP16(curr, "yfov"))        { camera.yFov        = ParseFloat(curr); }
-            else if (StrCMP16(curr, "xmag"))        { camera.xmag        = ParseFloat(curr); }
-            else if (StrCMP16(curr, "ymag"))        { camera.ymag        = ParseFloat(curr); }
-            else { ASSERT(0); return (const char*)AError_UNKNOWN_CAMERA_VAR; }
+            __m256i a = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(src + i * 4 + 32));
+            __m256i r = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8); // packus works in lanes
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi16(r, vbase));
         }
-        end_properties:{}
+        break;
     }
-    return nullptr;
-}
-
-__private const char* ParseScenes(const char* curr, Array<AScene>& scenes, 
-                                  AStringAllocator& stringAllocator, FixedSizeGrowableAllocator<int>& intAllocator)
-{
-    curr = SkipUntill(curr, '[');
-    curr++;
-    AScene scene{};
-    // read each node
-    while (true)
+#elif defined(AX_SUPPORT_SSE) && !defined(AX_ARM)
+    __m128i vbase = _mm_set1_epi16((short)base), zero = _mm_setzero_si128();
+    switch (srcType)
     {
-        // search for name
-        while (*curr && *curr != '"')
+        case 1:
+        for (; i + 16 <= count; i += 16)
         {
-            if (*curr == '}')
-            {
-                scenes.Add(scene);
-                MemsetZero(&scene, sizeof(AScene));
-            }
-            if (*curr++ == ']') return curr; // end all scenes
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            _mm_storeu_si128((__m128i*)(dst + i),     _mm_add_epi16(_mm_unpacklo_epi8(v, zero), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_add_epi16(_mm_unpackhi_epi8(v, zero), vbase));
         }
-        ASSERT(*curr != '\0' && "parsing scenes not possible, probably forgot to close brackets!");
-        curr++; // skips the "
-        
-        if (StrCMP16(curr, "nodes"))
+        break;
+        case 3:
+        for (; i + 16 <= count; i += 16)
         {
-            // find how many childs there are:
-            while (!IsNumber(*curr)) curr++;
-            const char* begin = curr;
-            scene.numNodes = 1;
-            while (true)
-            {
-                scene.numNodes += *curr == ',';
-                if (*curr++ == ']') break;
-            }
-            curr = begin;
-            scene.nodes = intAllocator.AllocateUninitialized(scene.numNodes);
-            scene.numNodes = 0;
-
-            while (*curr != ']')
+            _mm_storeu_si128((__m128i*)(dst + i),     _mm_add_epi16(_mm_loadu_si128((const __m128i*)(src + i * 2)), vbase));
+            _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_add_epi16(_mm_loadu_si128((const __m128i*)(src + i * 2 + 16)), vbase));
+        }
+        break;
+        default:
+        {
+            // sse2 doesn't have packus_epi32, indices are biased to signed range and packed with saturation
+            __m128i bias32 = _mm_set1_epi32(32768), bias16 = _mm_set1_epi16((short)0x8000);
+            for (; i + 16 <= count; i += 16)
             {
-                if (IsNumber(*curr))
+                for (int k = 0; k < 16; k += 8)
                 {
-                    scene.nodes[scene.numNodes] = ParsePositiveNumber(curr);
-                    scene.numNodes++;
+                    __m128i a = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(src + (i + k) * 4)), bias32);
+                    __m128i b = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(src + (i + k) * 4 + 16)), bias32);
+                    __m128i r = _mm_xor_si128(_mm_packs_epi32(a, b), bias16);
+                    _mm_storeu_si128((__m128i*)(dst + i + k), _mm_add_epi16(r, vbase));
                 }
-                curr++;
             }
-            curr++;// skip ]
         }
-        else if (StrCMP16(curr, "name"))
+        break;
+    }
+#elif defined(AX_ARM)
+    uint16x8_t vbase = vdupq_n_u16((uint16_t)base);
+    switch (srcType)
+    {
+        case 1:
+        for (; i + 16 <= count; i += 16)
         {
-            curr = CopyStringInQuotes(scene.name, curr + 5, stringAllocator);
+            uint8x16_t v = vld1q_u8((const uint8_t*)(src + i));
+            vst1q_u16(dst + i,     vaddw_u8(vbase, vget_low_u8(v)));
+            vst1q_u16(dst + i + 8, vaddw_u8(vbase, vget_high_u8(v)));
         }
-    } 
+        break;
+        case 3:
+        for (; i + 16 <= count; i += 16)
+        {
+            vst1q_u16(dst + i,     vaddq_u16(vld1q_u16((const uint16_t*)(src + i * 2)), vbase));
+            vst1q_u16(dst + i + 8, vaddq_u16(vld1q_u16((const uint16_t*)(src + i * 2 + 16)), vbase));
+        }
+        break;
+        default:
+        for (; i + 16 <= count; i += 16)
+        {
+            for (int k = 0; k < 16; k += 8)
+            {
+                uint16x4_t a = vmovn_u32(vld1q_u32((const uint32_t*)(src + (i + k) * 4)));
+                uint16x4_t b = vmovn_u32(vld1q_u32((const uint32_t*)(src + (i + k) * 4 + 16)));
+                vst1q_u16(dst + i + k, vaddq_u16(vcombine_u16(a, b), vbase));
+            }
+        }
+        break;
+    }
+#endif
+    switch (srcType)
+    {
+        case 1:  for (; i < count; i++) dst[i] = (uint16_t)(((const uint8_t*)src)[i]  + base); break;
+        case 3:  for (; i < count; i++) dst[i] = (uint16_t)(((const uint16_t*)src)[i] + base); break;
+        default: for (; i < count; i++) dst[i] = (uint16_t)(((const uint32_t*)src)[i] + base); break;
+    }
 }
-inline char OGLWrapToWrap(int wrap)
+
+__public void ARebaseIndices(void* dst, int dstType, const void* src, int srcType, int count, unsigned base)
 {
-    switch (wrap)
+    ASSERT((srcType == 1 || srcType == 3 || srcType == 5) && (dstType == 3 || dstType == 5));
+    if (dstType == 3) RebaseIndices16((uint16_t*)dst, (const char*)src, srcType, count, base);
+    else              RebaseIndices32((uint32_t*)dst, (const char*)src, srcType, count, base);
+}
+
+// pointer and stride of the attribute, sparse attributes are densified. null if primitive doesn't have the attribute
+__private const char* AttributeData(APrimitive& primitive, AAttribType attrib, int defaultStride, int* stride)
+{
+    if (!(primitive.attributes & attrib)) return nullptr;
+    int index = TrailingZeroCount32(attrib);
+    *stride = primitive.vertexStrides[index] ? primitive.vertexStrides[index] : defaultStride;
+    if (!(primitive.sparseAttributes & attrib)) 
+        return (const char*)primitive.vertexAttribs[index];
+    *stride = defaultStride;
+    return (const char*)ASparseGetDense((ASparseAccessor*)primitive.vertexAttribs[index]);
+}
+
+// source stride of tightly packed attributes, joint and weight strides are 0 because packers know their size
+static const int AAttribStrides[AAttribType_Count]    = { 12, 8, 12, 16, 8, 0, 0 };
+static const int AAttribComponents[AAttribType_Count] = { 3, 2, 3, 4, 2, 4, 4 };
+
+// bytes that element writes to the vertex, packed encodings are 32 bit
+inline int VertexElementSize(const AVertexElement& element)
+{
+    return element.encoding == AVertexEncoding_Float ? AAttribComponents[TrailingZeroCount32(element.attrib)] * 4 : 4;
+}
+
+// true if some bytes of the vertex are not written by any of the elements
+__private bool VertexHasGaps(const AVertexElement* elements, int numElements, int vertexSize)
+{
+    char* covered = (char*)AX_MALLOC(vertexSize);
+    MemsetZero(covered, vertexSize);
+    for (int e = 0; e < numElements; e++)
     {
-        case 0x2901: return 0; // GL_REPEAT          10497
-        case 0x812F: return 1; // GL_CLAMP_TO_EDGE   33071
-        case 0x812D: return 2; // GL_CLAMP_TO_BORDER 33069
-        case 0x8370: return 3; // GL_MIRRORED_REPEAT 33648
-        default: ASSERT(0 && "wrong or undefined sampler type!"); return 0;
+        int size = MIN(VertexElementSize(elements[e]), vertexSize - elements[e].offset);
+        if (size > 0) SmallMemSet(covered + elements[e].offset, 1, size);
+    }
+    bool hasGaps = false;
+    for (int i = 0; i < vertexSize; i++)
+        hasGaps |= covered[i] == 0;
+    AX_FREE(covered);
+    return hasGaps;
+}
+
+// packs one attribute of the primitive, kernel is selected here once so vertex loops doesn't have branches
+__private void PackAttribute(APrimitive& primitive, const AVertexElement& element, char* vertices, int vertexSize)
+{
+    int index = TrailingZeroCount32(element.attrib);
+    int count = primitive.numVertices;
+    int numComponents = AAttribComponents[index];
+    char* dst = vertices + element.offset;
+    int stride = 0;
+    const char* data = AttributeData(primitive, element.attrib, AAttribStrides[index], &stride);
+    
+    if (data == nullptr)
+    {
+        for (int i = 0; i < VertexElementSize(element); i += 4)
+            ZeroAttribute(dst + i, vertexSize, count);
+        return;
+    }
+
+    switch (element.encoding)
+    {
+        case AVertexEncoding_Float:    PackFloats(dst, vertexSize, data, stride, count, numComponents); break;
+        case AVertexEncoding_Snorm10:  
+            if (numComponents == 4) PackNormals<4>(dst, vertexSize, data, stride, count);
+            else                    PackNormals<3>(dst, vertexSize, data, stride, count); 
+            break;
+        case AVertexEncoding_Half2:    PackTexCoords(dst, vertexSize, data, stride, count); break;
+        case AVertexEncoding_Uint8x4:  PackJoints(dst, vertexSize, data, stride, count, primitive.jointType, primitive.jointCount); break;
+        case AVertexEncoding_Unorm8x4: PackWeights(dst, vertexSize, data, stride, count, primitive.weightType, primitive.jointCount); break;
+        default: ASSERT(0 && "unknown vertex encoding"); break;
+    }
+}
+
+__public void ACreateVerticesIndicesLayout(SceneBundle* scene, const AVertexElement* elements, int numElements, int vertexSize)
+{
+    // previous call's output is replaced, everything is packed again from the source indices and attributes
+    if (OwnedByScene(scene, scene->allVertices)) FreeAligned(scene->allVertices);
+    if (OwnedByScene(scene, scene->allIndices))  FreeAligned(scene->allIndices);
+    FreeMeshlets(scene); // they index old vertices
+
+    scene->totalVertices = scene->totalIndices = 0;
+    for (int m = 0; m < scene->numMeshes; m++)
+    {
+        for (int p = 0; p < scene->meshes[m].numPrimitives; p++)
+        {
+            APrimitive& primitive = scene->meshes[m].primitives[p];
+            primitive.numVertices = primitive.numSourceVertices; // welding might have changed it
+            scene->totalVertices += primitive.numVertices;
+            scene->totalIndices  += primitive.numIndices;
+        }
+    }
+
+    scene->allVertices = AllocAligned((int64_t)vertexSize * MAX(scene->totalVertices, 1), 16);
+    scene->allIndices  = AllocAligned(sizeof(uint32_t) * MAX(scene->totalIndices, 1), 16);
+    scene->vertexSize  = vertexSize;
+
+    char* currVertex = (char*)scene->allVertices;
+    uint32_t* currIndices = (uint32_t*)scene->allIndices;
+    int vertexCursor = 0, indexCursor = 0;
+    // padding of the vertex is zeroed, so output doesn't depend on old memory and vertices can be compared bytewise
+    bool hasGaps = VertexHasGaps(elements, numElements, vertexSize);
+
+    for (int m = 0; m < scene->numMeshes; m++)
+    {
+        AMesh& mesh = scene->meshes[m];
+        for (int p = 0; p < mesh.numPrimitives; p++)
+        {
+            APrimitive& primitive = mesh.primitives[p];
+            if (primitive.sourceIndices) 
+                ARebaseIndices(currIndices, 5, primitive.sourceIndices, primitive.sourceIndexType, primitive.numIndices, vertexCursor);
+            
+            if (hasGaps)
+                MemsetZero(currVertex, (size_t)primitive.numVertices * vertexSize);
+            for (int e = 0; e < numElements; e++)
+                PackAttribute(primitive, elements[e], currVertex, vertexSize);
+
+            primitive.indices     = currIndices;
+            primitive.indexType   = 5; // GL_UNSIGNED_INT
+            primitive.vertices    = currVertex;
+            primitive.indexOffset = indexCursor;
+
+            currVertex   += (int64_t)primitive.numVertices * vertexSize;
+            currIndices  += primitive.numIndices;
+            vertexCursor += primitive.numVertices;
+            indexCursor  += primitive.numIndices;
+        }
     }
 }
 
-__private const char* ParseSamplers(const char* curr, Array<ASampler>& samplers)
+__public void ACreateVerticesIndices(SceneBundle* scene)
 {
-    curr = SkipUntill(curr, '[');
-    curr++;
-    
-    ASampler sampler{};
+    ASkinnedVertexLayout::Pack(scene);
+}
+
+/*****************************************************************
+*                       Mesh Optimization                        *
+*****************************************************************/
+
+// passes that work on allIndices after ACreateVerticesIndices, each primitive is processed on it's own thread.
+// indices of the primitive are in [base, base + numVertices), base is the primitive's first vertex in allVertices
+
+struct APrimitiveRange
+{
+    APrimitive* primitive;
+    uint32_t*   indices;
+    uint32_t    base;
+    int         missesBefore;
+    int         missesAfter;
+    int         numUnique; // vertices after welding
+};
+
+// ranges of triangle primitives in mesh order, returns number of ranges. free with AX_FREE
+__private APrimitiveRange* CollectPrimitiveRanges(SceneBundle* scene, int* numRanges)
+{
+    int numPrimitives = 0;
+    for (int m = 0; m < scene->numMeshes; m++)
+        numPrimitives += scene->meshes[m].numPrimitives;
     
-    // read each node
-    while (true)
+    APrimitiveRange* ranges = (APrimitiveRange*)AX_MALLOC(sizeof(APrimitiveRange) * MAX(numPrimitives, 1));
+    int count = 0, indexCursor = 0;
+    for (int m = 0; m < scene->numMeshes && scene->allIndices && scene->vertexSize; m++)
     {
-        // search for name
-        while (*curr && *curr != '"')
+        for (int p = 0; p < scene->meshes[m].numPrimitives; p++)
         {
-            if (*curr == '}')
-            {
-                samplers.Add(sampler);
-                MemsetZero(&sampler, sizeof(ASampler));
-            }
-            if (*curr++ == ']') return curr; // end all nodes
-        }
-        ASSERT(*curr != '\0' && "parsing nodes not possible, probably forgot to close brackets!");
-        curr++; // skips the "
+            APrimitive& primitive = scene->meshes[m].primitives[p];
+            // primitives that AWeldVertices found identical share the first one's vertices and indices, it is processed once
+            if (primitive.indexOffset < indexCursor) continue;
+            indexCursor = primitive.indexOffset + primitive.numIndices;
 
-        if      (StrCMP16(curr, "magFilter")) sampler.magFilter = (char)(ParsePositiveNumber(curr) - 0x2600); // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
-        else if (StrCMP16(curr, "minFilter")) sampler.minFilter = (char)(ParsePositiveNumber(curr) - 0x2600); // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
-        else if (StrCMP16(curr, "wrapS"))     sampler.wrapS = (char)OGLWrapToWrap(ParsePositiveNumber(curr));
-        else if (StrCMP16(curr, "wrapT"))     sampler.wrapT = (char)OGLWrapToWrap(ParsePositiveNumber(curr));
-        else { ASSERT(0 && "parse samplers failed!"); return (const char*)AError_UNKNOWN; }
+            bool triangles = primitive.mode == 4 && primitive.numIndices % 3 == 0 && primitive.indexType == 5;
+            if (!triangles || primitive.numIndices == 0) continue;
+            
+            uint32_t base = (uint32_t)(((char*)primitive.vertices - (char*)scene->allVertices) / scene->vertexSize);
+            ranges[count++] = { &primitive, (uint32_t*)scene->allIndices + primitive.indexOffset, base, 0, 0, primitive.numVertices };
+        }
     }
+    *numRanges = count;
+    return ranges;
 }
 
-__private const char* ParseMaterialTexture(const char* curr, AMaterial::Texture& texture)
+enum { AVertexCacheSize = 32, AFifoCacheSize = 16, AMaxValenceScore = 64 };
+
+// misses of fifo post transform cache, acmr is misses / triangles. timestamps has numVertices elements
+__private int CacheMisses(const uint32_t* indices, int numIndices, uint32_t base, int numVertices, uint32_t* timestamps)
 {
-    curr = SkipUntill(curr, '{');
-    curr++;
-    while (true)
+    MemsetZero(timestamps, sizeof(uint32_t) * numVertices);
+    uint32_t time = AFifoCacheSize + 1;
+    int misses = 0;
+    for (int i = 0; i < numIndices; i++)
     {
-        while (*curr && *curr != '"')
+        uint32_t v = indices[i] - base;
+        if (time - timestamps[v] > AFifoCacheSize)
         {
-            if (*curr++ == '}') return curr;
+            timestamps[v] = time++;
+            misses++;
         }
-        ASSERT(*curr && "parsing material failed, probably forgot to close brackets");
-        curr++;
+    }
+    return misses;
+}
 
-        if (StrCMP16(curr, "scale")) {
-            curr = ParseFloat16(curr, texture.scale);
-        }
-        else if (StrCMP16(curr, "index")) {
-            texture.index = (char)ParsePositiveNumber(curr);
-        }
-        else if (StrCMP16(curr, "texCoord")) {
-            texture.texCoord = (char)ParsePositiveNumber(curr);
-        }
-        else if (StrCMP16(curr, "strength")) {
-            curr = ParseFloat16(curr, texture.strength);
-        }
-        else if (StrCMP16(curr, "extensions")) {
-            curr = SkipToNextNode(curr, '{', '}'); // currently extensions are not supported 
-        }
-        else {
-            ASSERT(0 && "unknown material texture value");
-            return (const char*)AError_UNKNOWN_MATERIAL_VAR;
-        }
+struct AForsythScores
+{
+    float cache[AVertexCacheSize];
+    float valence[AMaxValenceScore];
+};
+
+// Tom Forsyth's Linear-Speed Vertex Cache Optimisation scores
+__private void InitForsythScores(AForsythScores& scores)
+{
+    for (int i = 0; i < AVertexCacheSize; i++)
+    {
+        if (i < 3) { scores.cache[i] = 0.75f; continue; } // last triangle's vertices
+        float x = 1.0f - float(i - 3) / float(AVertexCacheSize - 3);
+        scores.cache[i] = x * Sqrt(x); // pow(x, 1.5)
     }
-    return nullptr;
+    scores.valence[0] = 0.0f;
+    for (int i = 1; i < AMaxValenceScore; i++)
+        scores.valence[i] = 2.0f / Sqrt((float)i); // boost vertices that has few triangles left
 }
-__forceinline uint32_t PackColorRGBAU32(float* c) {
-    return (uint32_t)(*c * 255.0f) | ((uint32_t)(c[1] * 255.0f) << 8) | ((uint32_t)(c[2] * 255.0f) << 16) | ((uint32_t)(c[3] * 255.0f) << 24);
+
+inline float ForsythScore(const AForsythScores& scores, int cachePosition, int valence)
+{
+    if (valence == 0) return -1.0f;
+    float score = cachePosition >= 0 ? scores.cache[cachePosition] : 0.0f;
+    return score + (valence < AMaxValenceScore ? scores.valence[valence] : scores.valence[AMaxValenceScore - 1]);
 }
 
-__private const char* ParseMaterials(const char* curr, Array<AMaterial>& materials, AStringAllocator& stringAllocator)
+// reorders triangles of the range in place, returns false if indices are out of the primitive
+__private bool OptimizeVertexCache(APrimitiveRange& range, const AForsythScores& scores)
 {
-    // mesh, name, children, 
-    // matrix, translation, rotation, scale
-    curr = SkipUntill(curr, '[');
-    curr++; // skip '['
-    AMaterial material{};
-    // read each material
-    while (true)
+    uint32_t* indices = range.indices;
+    int numIndices    = range.primitive->numIndices;
+    int numVertices   = range.primitive->numVertices;
+    int numTriangles  = numIndices / 3;
+    uint32_t base     = range.base;
+
+    for (int i = 0; i < numIndices; i++)
+        if (indices[i] - base >= (uint32_t)numVertices) return false;
+
+    // one block for all of the temporary arrays
+    uint64_t size = sizeof(int) * (numVertices * 4 + numTriangles * 3) + sizeof(float) * (numVertices + numTriangles) 
+                  + sizeof(uint32_t) * numIndices + numTriangles;
+    char* block = (char*)AX_MALLOC(size);
+    int* live          = (int*)block;              // triangles left for each vertex
+    int* offsets       = live + numVertices;       // start of the vertex's triangles in adjacency
+    int* cachePosition = offsets + numVertices;    
+    int* cursor        = cachePosition + numVertices;
+    int* adjacency     = cursor + numVertices;     // triangles of each vertex
+    float* vertexScore = (float*)(adjacency + numTriangles * 3);
+    float* triScore    = vertexScore + numVertices;
+    uint32_t* output   = (uint32_t*)(triScore + numTriangles);
+    uint8_t* emitted   = (uint8_t*)(output + numIndices);
+
+    range.missesBefore = CacheMisses(indices, numIndices, base, numVertices, (uint32_t*)cursor);
+
+    MemsetZero(live, sizeof(int) * numVertices);
+    for (int i = 0; i < numIndices; i++)
+        live[indices[i] - base]++;
+    
+    for (int v = 0, offset = 0; v < numVertices; v++)
     {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}')
-            {
-                materials.Add(material);
-                MemsetZero(&material, sizeof(AMaterial));
-                material.baseColorTexture.index = -1;
-            }
-            if (*curr++ == ']') return curr; // end all nodes
-        }
-        ASSERT(*curr && "parsing material failed, probably forgot to close brackets");
+        offsets[v] = cursor[v] = offset;
+        offset += live[v];
+        cachePosition[v] = -1;
+        vertexScore[v] = ForsythScore(scores, -1, live[v]);
+    }
 
-        int texture = -1;
-        curr++; // skips the "
-        if (StrCMP16(curr, "name"))
-        {
-            curr = CopyStringInQuotes(material.name, curr + 5, stringAllocator);
-        }
-        else if (StrCMP16(curr, "doubleSided"))
+    for (int t = 0; t < numIndices / 3; t++)
+        for (int k = 0; k < 3; k++)
+            adjacency[cursor[indices[t * 3 + k] - base]++] = t;
+
+    int bestTriangle = 0;
+    for (int t = 0; t < numTriangles; t++)
+    {
+        triScore[t] = vertexScore[indices[t * 3] - base] + vertexScore[indices[t * 3 + 1] - base] + vertexScore[indices[t * 3 + 2] - base];
+        if (triScore[t] > triScore[bestTriangle]) bestTriangle = t;
+        emitted[t] = 0;
+    }
+
+    int cache[AVertexCacheSize + 3];
+    int cacheCount = 0;
+    int inputCursor = 0; // for finding not emitted triangle when cache has no candidates
+
+    for (int outTriangle = 0; outTriangle < numTriangles; outTriangle++)
+    {
+        if (bestTriangle < 0)
         {
-            curr += sizeof("doubleSided'"); // skip doubleSided"
-            AX_NO_UNROLL while (!IsLower(*curr)) curr++;
-            material.doubleSided = *curr == 't';
+            while (emitted[inputCursor]) inputCursor++;
+            bestTriangle = inputCursor;
         }
-        else if (StrCMP16(curr, "pbrMetallicRoug")) //pbrMetallicRoughhness
+
+        const uint32_t* tri = indices + bestTriangle * 3;
+        int newCache[AVertexCacheSize + 3];
+        int newCount = 0;
+
+        for (int k = 0; k < 3; k++)
         {
-            curr = SkipUntill(curr, '{');
-    
-            // parse until finish
-            while (true)
+            int v = (int)(tri[k] - base);
+            output[outTriangle * 3 + k] = tri[k];
+
+            // remove triangle from the vertex's adjacency
+            int* vertexTriangles = adjacency + offsets[v];
+            for (int j = 0; j < live[v]; j++)
             {
-                // search for name
-                while (*curr && *curr != '"')
-                {
-                    if (*curr++ == '}') { goto pbr_end; }
-                }
-                curr++; // skips the "
-                
-                if      (StrCMP16(curr, "baseColorTex"))  { curr = ParseMaterialTexture(curr, material.baseColorTexture); }
-                else if (StrCMP16(curr, "metallicRough")) { curr = ParseMaterialTexture(curr, material.metallicRoughnessTexture); }
-                else if (StrCMP16(curr, "baseColorFact"))
-                {
-                    float baseColorFactor[4] = { ParseFloat(curr), ParseFloat(curr), ParseFloat(curr), ParseFloat(curr)};
-                    material.baseColorFactor = PackColorRGBAU32(baseColorFactor);
-                    curr = SkipUntill(curr, ']');
-                    curr++;
-                }
-                else if (StrCMP16(curr, "metallicFact"))
-                {
-                    curr = ParseFloat16(curr, material.metallicFactor);
-                }
-                else if (StrCMP16(curr, "roughnessFact"))
-                {
-                    curr = ParseFloat16(curr, material.roughnessFactor);
-                }
-                else
-                {
-                    ASSERT(0 && "unknown pbrMetallicRoughness value!");
-                    return (char*)AError_UNKNOWN_PBR_VAR;
-                }
+                if (vertexTriangles[j] != bestTriangle) continue;
+                vertexTriangles[j] = vertexTriangles[live[v] - 1];
+                break;
             }
-            pbr_end: {}
+            live[v]--;
+            if (k == 0 || (v != newCache[0] && v != newCache[newCount - 1])) // degenerate triangles
+                newCache[newCount++] = v;
         }
-        else if (StrCMP16(curr, "normalTexture"))    texture = 0;
-        else if (StrCMP16(curr, "occlusionTextur"))  texture = 1;
-        else if (StrCMP16(curr, "emissiveTexture"))  texture = 2;
-        else if (StrCMP16(curr, "emissiveFactor")) 
-        {
-            curr = ParseFloat16(curr, material.emissiveFactor[0]); 
-            curr = ParseFloat16(curr, material.emissiveFactor[1]);
-            curr = ParseFloat16(curr, material.emissiveFactor[2]);
-            curr = SkipUntill(curr, ']');
-            curr++;
-        }
-        else if (StrCMP16(curr, "extensions"))
-        {
-            curr = SkipToNextNode(curr, '{', '}'); // currently extensions are not supported 
-        }
-        else if (StrCMP16(curr, "alphaMode"))
+        emitted[bestTriangle] = 1;
+
+        for (int i = 0; i < cacheCount; i++)
         {
-            char text[16]={0};
-            curr += sizeof("alphaMode'");
-            curr = SkipUntill(curr, '"');
-            curr = GetStringInQuotes(text, curr);
-                 if (StrCMP16(text, "OPAQUE")) material.alphaMode = AMaterialAlphaMode_Opaque;
-            else if (StrCMP16(text, "MASK"))   material.alphaMode = AMaterialAlphaMode_Mask;
-            else if (StrCMP16(text, "BLEND"))  material.alphaMode = AMaterialAlphaMode_Blend;
+            int v = cache[i];
+            bool inTriangle = false;
+            for (int k = 0; k < MIN(newCount, 3); k++) inTriangle |= newCache[k] == v;
+            if (!inTriangle) newCache[newCount++] = v;
         }
-        else if (StrCMP16(curr, "alphaCutoff"))
+
+        // vertices that fall out of the cache lose their cache score
+        for (int i = AVertexCacheSize; i < newCount; i++)
+            cachePosition[newCache[i]] = -1;
+        
+        cacheCount = MIN(newCount, (int)AVertexCacheSize);
+        for (int i = 0; i < cacheCount; i++)
+            cachePosition[newCache[i]] = i;
+
+        // update scores of the vertices that are effected and their triangles
+        for (int i = 0; i < newCount; i++)
         {
-            material.alphaCutoff = ParseFloat(curr);
-        }
-        else {
-            ASSERT(0 && "undefined material variable!");
-            return (const char*)AError_UNKNOWN_MATERIAL_VAR;
+            int v = newCache[i];
+            float score = ForsythScore(scores, cachePosition[v], live[v]);
+            float diff  = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            const int* vertexTriangles = adjacency + offsets[v];
+            for (int j = 0; j < live[v]; j++)
+                triScore[vertexTriangles[j]] += diff;
         }
 
-        if (texture != -1)
+        // next triangle is the best one that uses a vertex in the cache
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (int i = 0; i < cacheCount; i++)
         {
-            curr = ParseMaterialTexture(curr, material.textures[texture]);
-            if ((uint64_t)curr == AError_UNKNOWN_MATERIAL_VAR) return curr;
+            int v = newCache[i];
+            const int* vertexTriangles = adjacency + offsets[v];
+            for (int j = 0; j < live[v]; j++)
+                if (triScore[vertexTriangles[j]] > bestScore)
+                    bestScore = triScore[vertexTriangles[j]], bestTriangle = vertexTriangles[j];
         }
+        SmallMemCpy(cache, newCache, sizeof(int) * cacheCount);
     }
-    return curr;
+
+    SmallMemCpy(indices, output, sizeof(uint32_t) * numIndices);
+    range.missesAfter = CacheMisses(indices, numIndices, base, numVertices, (uint32_t*)cursor);
+    AX_FREE(block);
+    return true;
 }
 
-static const char* ParseSkins(const char* curr, Array<ASkin>& skins, AStringAllocator& stringAllocator, AIntAllocator& intAllocator)
+static void OptimizeVertexCacheTask(int index, void* arg)
 {
-    curr = SkipAfter(curr, '[');
-    
-    ASkin skin{};
-    skin.skeleton = -1;
+    APrimitiveRange& range = ((APrimitiveRange*)arg)[index];
+    AForsythScores scores;
+    InitForsythScores(scores);
+    if (!OptimizeVertexCache(range, scores))
+        range.missesBefore = range.missesAfter = 0;
+}
 
-    // read each node
-    while (true)
-    {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}')
-            {
-                skins.Add(skin);
-                MemsetZero(&skin, sizeof(ASkin));
-                skin.skeleton = -1;
-            }
-            if (*curr++ == ']') return curr; // end all nodes
-        }
-        ASSERT(*curr != '\0' && "parsing skins not possible, probably forgot to close brackets!");
-        curr++; // skips the "
+__public void AOptimizeVertexCache(SceneBundle* scene, int numThreads, float* acmrBefore, float* acmrAfter)
+{
+    int numRanges;
+    APrimitiveRange* ranges = CollectPrimitiveRanges(scene, &numRanges);
+    AParallelFor(numRanges, OptimizeVertexCacheTask, ranges, numThreads);
 
-        if (StrCMP16(curr, "inverseBindMatrices"))
-        {
-            // we will parse later, because we are not sure we are parsed accessors at this point
-            skin.inverseBindMatrices = (float*)(size_t)ParsePositiveNumber(curr);
-        }
-        else if (StrCMP16(curr, "skeleton"))            skin.skeleton = ParsePositiveNumber(curr);
-        else if (StrCMP16(curr, "name"))                curr = CopyStringInQuotes(skin.name, curr + 5, stringAllocator);
-        else if (StrCMP16(curr, "joints"))
-        {
-            IntPtrPair result = ParseIntArray(curr, intAllocator);
-            skin.numJoints = result.numElements;
-            skin.joints = result.ptr;
-            curr++; // skip ]
-        }
+    int64_t missesBefore = 0, missesAfter = 0, numTriangles = 0;
+    for (int i = 0; i < numRanges; i++)
+    {
+        missesBefore += ranges[i].missesBefore;
+        missesAfter  += ranges[i].missesAfter;
+        numTriangles += ranges[i].primitive->numIndices / 3;
     }
-    return curr;
+    numTriangles = MAX(numTriangles, (int64_t)1);
+    if (acmrBefore) *acmrBefore = float(missesBefore) / float(numTriangles);
+    if (acmrAfter)  *acmrAfter  = float(missesAfter)  / float(numTriangles);
+    AX_FREE(ranges);
 }
 
-static const char* ParseAnimations(const char* curr, Array<AAnimation>& animations, 
-                                   AStringAllocator& stringAllocator, AIntAllocator& intAllocator)
+// vertices are moved into first use order so gpu reads vertex buffer almost linearly
+__private void OptimizeVertexFetch(APrimitiveRange& range, int vertexSize)
 {
-    curr = SkipAfter(curr, '[');
-    Array<AAnimChannel> channels;
-    Array<AAnimSampler> samplers;
+    uint32_t* indices = range.indices;
+    int numIndices    = range.primitive->numIndices;
+    int numVertices   = range.primitive->numVertices;
+    uint32_t base     = range.base;
 
-    AAnimation animation{};
-    // read each node
-    while (true)
+    for (int i = 0; i < numIndices; i++)
+        if (indices[i] - base >= (uint32_t)numVertices) return;
+
+    char* block = (char*)AX_MALLOC(sizeof(uint32_t) * numVertices + (uint64_t)vertexSize * numVertices);
+    uint32_t* remap = (uint32_t*)block;
+    char* reordered = block + sizeof(uint32_t) * numVertices;
+    MemSet32(remap, ~0u, numVertices);
+
+    uint32_t next = 0;
+    for (int i = 0; i < numIndices; i++)
     {
-        // search for name
-        while (*curr && *curr != '"')
-        {
-            if (*curr == '}')
-            {
-                animation.numSamplers = samplers.Size();
-                animation.numChannels = channels.Size();
-                animation.samplers = samplers.TakeOwnership();
-                animation.channels = channels.TakeOwnership();
-                animations.Add(animation);
-                MemsetZero(&animation, sizeof(AAnimation));
-            }
-            if (*curr++ == ']') 
-                return curr; // end all nodes
-        }
-        ASSERT(*curr != '\0' && "parsing animations not possible, probably forgot to close brackets!");
-        curr++; // skips the "
+        uint32_t v = indices[i] - base;
+        if (remap[v] == ~0u) remap[v] = next++;
+        indices[i] = base + remap[v];
+    }
 
-        if (StrCMP16(curr, "name"))
-        {
-            curr = CopyStringInQuotes(animation.name, curr + sizeof("name'"), stringAllocator);
-        }
-        else if (StrCMP16(curr, "channels"))
-        {
-            curr += sizeof("channels'");
-            AAnimChannel channel;
-            bool parsingTarget = false;
-            while (true)
-            {
-                while (*curr && *curr != '"')
-                {
-                    if (*curr == ']') { curr++; /* skip ] */ goto end_parsing; }
-                    if (*curr == '}') 
-                    {
-                        if (parsingTarget) parsingTarget = false;
-                        else 
-                        {
-                            channels.Add(channel);
-                            MemsetZero(&channel, sizeof(AAnimChannel));
-                        }
-                    }
-                    curr++;
-                }
-                ASSERT(*curr != '\0' && "parsing anim channels not possible, probably forgot to close brackets!");
+    char* vertices = (char*)range.primitive->vertices;
+    for (int v = 0; v < numVertices; v++)
+    {
+        if (remap[v] == ~0u) remap[v] = next++; // not used by any triangle
+        SmallMemCpy(reordered + (uint64_t)remap[v] * vertexSize, vertices + (uint64_t)v * vertexSize, vertexSize);
+    }
+    SmallMemCpy(vertices, reordered, (uint64_t)vertexSize * numVertices);
+    AX_FREE(block);
+}
 
-                uint64_t hash;
-                curr = HashStringInQuotes(&hash, curr);
+struct AVertexFetchJob
+{
+    APrimitiveRange* ranges;
+    int vertexSize;
+};
 
-                switch (hash)
-                {
-                    case AHashString8("sampler"): channel.sampler = ParsePositiveNumber(curr);     break;
-                    case AHashString8("node"):    channel.targetNode = ParsePositiveNumber(curr);  break;
-                    case AHashString8("target"):  curr += sizeof("target'"); parsingTarget = true; break; 
-                    case AHashString8("path"):
-                    {
-                        curr = SkipAfter(curr, '"');
-                        switch (*curr) {
-                            case 't': channel.targetPath = AAnimTargetPath_Translation; curr += sizeof("translation'"); break;
-                            case 'r': channel.targetPath = AAnimTargetPath_Rotation;    curr += sizeof("rotation'"); break;
-                            case 's': channel.targetPath = AAnimTargetPath_Scale;       curr += sizeof("scale'"); break;
-                            default: ASSERT(0 && "Unknown animation path value");
-                        };
-                        break;
-                    }
-                    default: ASSERT(0 && "Unknown animation channel value");
-                };
-            }
-        }
-        else if (StrCMP16(curr, "samplers"))
-        {
-            curr += sizeof("samplers'");
-            AAnimSampler sampler;
-            while (true)
-            {
-                while (*curr && *curr != '"')
-                {
-                    if (*curr == ']') { curr++; /* skip ] */ goto end_parsing; }
-                    if (*curr == '}') 
-                    {
-                        samplers.Add(sampler);
-                        MemsetZero(&sampler, sizeof(AAnimSampler));
-                    }
-                    curr++;
-                }
-                ASSERT(*curr != '\0' && "parsing anim channels not possible, probably forgot to close brackets!");
+static void OptimizeVertexFetchTask(int index, void* arg)
+{
+    AVertexFetchJob* job = (AVertexFetchJob*)arg;
+    OptimizeVertexFetch(job->ranges[index], job->vertexSize);
+}
 
-                uint64_t hash;
-                curr = HashStringInQuotes(&hash, curr);
+__public void AOptimizeVertexFetch(SceneBundle* scene, int numThreads)
+{
+    if (scene->allVertices == nullptr || scene->vertexSize == 0) return;
+    AVertexFetchJob job;
+    int numRanges;
+    job.ranges = CollectPrimitiveRanges(scene, &numRanges);
+    job.vertexSize = scene->vertexSize;
+    AParallelFor(numRanges, OptimizeVertexFetchTask, &job, numThreads);
+    AX_FREE(job.ranges);
+}
 
-                switch (hash)
-                {
-                    case AHashString8("input"):         sampler.input  = (float*)(size_t)ParsePositiveNumber(curr); break;
-                    case AHashString8("output"):        sampler.output = (float*)(size_t)ParsePositiveNumber(curr); break;
-                    case AHashString8("interpol"): // you've been searching from interpol hands up!!
-                    {
-                        curr += sizeof("interpolation") - sizeof("interpol");
-                        curr = SkipAfter(curr, '"');
-                        switch (*curr)
-                        {
-                            case 'L': sampler.interpolation = 0; curr += sizeof("Linear'");      break; // Linear
-                            case 'S': sampler.interpolation = 1; curr += sizeof("Step'");        break; // Step
-                            case 'C': sampler.interpolation = 2; curr += sizeof("CubicSpline'"); break; // CubicSpline
-                            default: ASSERT(0 && "Unknown animation path value"); break;
-                        };
-                        break;
-                    }
-                    default: ASSERT(0 && "Unknown animation sampler value"); break;
-                };
+// welding hashes and compares whole vertices, padding bytes are zeroed by ACreateVerticesIndicesLayout so they are equal too
+__private uint64_t HashBytes(const char* data, uint64_t size, uint64_t hash)
+{
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        hash = (hash ^ UnalignedLoad64(data)) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    uint64_t tail = 0;
+    SmallMemCpy(&tail, data, size);
+    hash = (hash ^ tail ^ size) * 0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 29);
+}
+
+__private bool BytesEqual(const char* a, const char* b, uint64_t size)
+{
+    for (; size >= 8; size -= 8, a += 8, b += 8)
+        if (UnalignedLoad64(a) != UnalignedLoad64(b)) return false;
+    while (size--) if (*a++ != *b++) return false;
+    return true;
+}
+
+// open addressing table size, at least twice of count so probes are short
+inline uint32_t HashTableSize(int count)
+{
+    uint32_t size = 16;
+    while (size < (uint32_t)count * 2u) size <<= 1;
+    return size;
+}
+
+// duplicate vertices of the primitive are removed, unique vertices are moved to start of the primitive's range
+__private void WeldVertices(APrimitiveRange& range, int vertexSize)
+{
+    uint32_t* indices = range.indices;
+    int numIndices    = range.primitive->numIndices;
+    int numVertices   = range.primitive->numVertices;
+    uint32_t base     = range.base;
+
+    for (int i = 0; i < numIndices; i++)
+        if (indices[i] - base >= (uint32_t)numVertices) return;
+
+    uint32_t tableSize = HashTableSize(numVertices), mask = tableSize - 1;
+    uint32_t* table = (uint32_t*)AX_MALLOC(sizeof(uint32_t) * (tableSize + numVertices));
+    uint32_t* remap = table + tableSize;
+    MemSet32(table, ~0u, tableSize);
+
+    char* vertices = (char*)range.primitive->vertices;
+    uint32_t numUnique = 0;
+    for (int v = 0; v < numVertices; v++)
+    {
+        const char* vertex = vertices + (uint64_t)v * vertexSize;
+        uint32_t slot = (uint32_t)HashBytes(vertex, vertexSize, 0) & mask;
+        while (true)
+        {
+            uint32_t id = table[slot];
+            if (id == ~0u)
+            {
+                // unique vertices are written in order, destination is always before the vertex
+                if (numUnique != (uint32_t)v) 
+                    SmallMemCpy(vertices + (uint64_t)numUnique * vertexSize, vertex, vertexSize);
+                table[slot] = remap[v] = numUnique++;
+                break;
             }
+            if (BytesEqual(vertices + (uint64_t)id * vertexSize, vertex, vertexSize))
+            {
+                remap[v] = id;
+                break;
+            }
+            slot = (slot + 1) & mask;
         }
-        end_parsing:{}
     }
-    return curr;
+
+    for (int i = 0; i < numIndices; i++)
+        indices[i] = base + remap[indices[i] - base];
+    
+    range.numUnique = (int)numUnique;
+    AX_FREE(table);
 }
 
-__public int ParseGLTF(const char* path, SceneBundle* result, float scale)
+static void WeldVerticesTask(int index, void* arg)
 {
-    ASSERT(result && path);
-    uint64_t sourceSize = 0;
-    char* source = ReadAllFile(path, nullptr);
-    MemsetZero(result, sizeof(SceneBundle));
-
-    if (source == nullptr) { result->error = AError_FILE_NOT_FOUND; ASSERT(0); return 0; }
+    AVertexFetchJob* job = (AVertexFetchJob*)arg;
+    WeldVertices(job->ranges[index], job->vertexSize);
+}
 
-#if defined(DEBUG) || defined(_DEBUG)
-    // ascii utf8 support check
-    // if (IsUTF8ASCII(source, sourceSize) != 1) { result->error = AError_NON_UTF8; return; }
-#endif
-    Array<GLTFBufferView> bufferViews ;
-    Array<GLTFBuffer>     buffers     ;
-    Array<GLTFAccessor>   accessors   ;
+// hash of primitive's vertices and indices relative to it's first vertex
+__private uint64_t HashPrimitive(const APrimitive& primitive, int vertexSize, uint32_t base)
+{
+    uint64_t hash = HashBytes((const char*)primitive.vertices, (uint64_t)vertexSize * primitive.numVertices, primitive.numIndices);
+    const uint32_t* indices = (const uint32_t*)primitive.indices;
+    for (int i = 0; i < primitive.numIndices; i++)
+        hash = (hash ^ (indices[i] - base)) * 0x9E3779B97F4A7C15ull, hash ^= hash >> 32;
+    return hash;
+}
 
-    AStringAllocator stringAllocator(2048);
-    FixedSizeGrowableAllocator<int> intAllocator(512);
+__private bool PrimitivesEqual(const APrimitive& a, uint32_t baseA, const APrimitive& b, uint32_t baseB, int vertexSize)
+{
+    if (a.numVertices != b.numVertices || a.numIndices != b.numIndices || a.mode != b.mode) return false;
+    if (!BytesEqual((const char*)a.vertices, (const char*)b.vertices, (uint64_t)vertexSize * a.numVertices)) return false;
+    const uint32_t* ia = (const uint32_t*)a.indices, *ib = (const uint32_t*)b.indices;
+    for (int i = 0; i < a.numIndices; i++)
+        if (ia[i] - baseA != ib[i] - baseB) return false;
+    return true;
+}
 
-    Array<AMesh>  meshes; Array<ANode>        nodes; Array<AMaterial> materials; Array<ATexture>  textures;
-    Array<AImage> images; Array<ASampler>  samplers; Array<ACamera>     cameras; Array<AScene>    scenes;
-    Array<ASkin>  skins; Array<AAnimation> animations;
+__public int AWeldVertices(SceneBundle* scene, int numThreads)
+{
+    if (scene->allVertices == nullptr || scene->vertexSize == 0) return 0;
+    const int vertexSize = scene->vertexSize;
+    AVertexFetchJob job;
+    int numRanges;
+    job.ranges = CollectPrimitiveRanges(scene, &numRanges);
+    job.vertexSize = vertexSize;
+    AParallelFor(numRanges, WeldVerticesTask, &job, numThreads);
+
+    // primitives are moved down to close the gaps, identical primitives point to the first one
+    int numPrimitives = 0;
+    for (int m = 0; m < scene->numMeshes; m++)
+        numPrimitives += scene->meshes[m].numPrimitives;
+    
+    uint32_t tableSize = HashTableSize(numPrimitives), mask = tableSize - 1;
+    APrimitive** table = (APrimitive**)AX_CALLOC(sizeof(APrimitive*) * tableSize);
+    // primitives that are shared by previous AWeldVertices call are updated at the end from their owner.
+    // owners are in increasing index offset order, shared ones are at the end of the same array
+    int* oldOffsets     = (int*)AX_MALLOC(sizeof(int) * MAX(numPrimitives, 1));
+    APrimitive** owners = (APrimitive**)AX_MALLOC(sizeof(APrimitive*) * MAX(numPrimitives, 1));
+    int numOwners = 0, numShared = 0;
+    
+    char* allVertices  = (char*)scene->allVertices;
+    uint32_t* allIndices = (uint32_t*)scene->allIndices;
+    uint32_t vertexCursor = 0;
+    int indexCursor = 0, r = 0, oldIndexEnd = 0;
+    int oldTotalVertices = scene->totalVertices;
 
-    const char* curr = source;
-    while (*curr)
+    for (int m = 0; m < scene->numMeshes; m++)
     {
-        // search for descriptor for example, accessors, materials, images, samplers
-        AX_NO_UNROLL while (*curr && *curr != '"') curr++;
-        
-        if (*curr == '\0') break;
+        for (int p = 0; p < scene->meshes[m].numPrimitives; p++)
+        {
+            APrimitive& primitive = scene->meshes[m].primitives[p];
+            if (primitive.indexOffset < oldIndexEnd)
+            {
+                owners[numPrimitives - ++numShared] = &primitive;
+                continue;
+            }
+            oldIndexEnd = primitive.indexOffset + primitive.numIndices;
+            if (primitive.numIndices > 0)
+            {
+                oldOffsets[numOwners] = primitive.indexOffset;
+                owners[numOwners++] = &primitive;
+            }
 
-        curr++; // skips the "
-        if      (StrCMP16(curr, "accessors"))    curr = ParseAccessors(curr, accessors);
-        else if (StrCMP16(curr, "scenes"))       curr = ParseScenes(curr, scenes, stringAllocator, intAllocator);
-        else if (StrCMP16(curr, "scene"))        result->defaultSceneIndex = ParsePositiveNumber(curr);
-        else if (StrCMP16(curr, "bufferViews"))  curr = ParseBufferViews(curr, bufferViews);
-        else if (StrCMP16(curr, "buffers"))      curr = ParseBuffers(curr, path, buffers);     
-        else if (StrCMP16(curr, "images"))       curr = ParseImages(curr, path, images, stringAllocator);       
-        else if (StrCMP16(curr, "textures"))     curr = ParseTextures(curr, textures, stringAllocator);   
-        else if (StrCMP16(curr, "meshes"))       curr = ParseMeshes(curr, meshes, stringAllocator);
-        else if (StrCMP16(curr, "materials"))    curr = ParseMaterials(curr, materials, stringAllocator);
-        else if (StrCMP16(curr, "nodes"))        curr = ParseNodes(curr, nodes, stringAllocator, intAllocator, scale);
-        else if (StrCMP16(curr, "samplers"))     curr = ParseSamplers(curr, samplers);    
-        else if (StrCMP16(curr, "cameras"))      curr = ParseCameras(curr, cameras, stringAllocator); 
-        else if (StrCMP16(curr, "skins"))        curr = ParseSkins(curr, skins, stringAllocator, intAllocator); 
-        else if (StrCMP16(curr, "animations"))   curr = ParseAnimations(curr, animations, stringAllocator, intAllocator); 
-        else if (StrCMP16(curr, "asset"))        curr = SkipToNextNode(curr, '{', '}'); // it just has text data that doesn't have anything to do with meshes, (author etc..) if you want you can add this feature :)
-        else if (StrCMP16(curr, "extensionsUsed") || StrCMP16(curr, "extensionsRequ")) curr = SkipToNextNode(curr, '[', ']');
-        else { ASSERT(0); curr = (const char*)AError_UNKNOWN_DESCRIPTOR; }
+            bool welded = r < numRanges && job.ranges[r].primitive == &primitive;
+            int numVertices = welded ? job.ranges[r++].numUnique : primitive.numVertices;
+            uint32_t base = (uint32_t)(((char*)primitive.vertices - allVertices) / vertexSize);
+            uint32_t shift = base - vertexCursor;
+            
+            // vertices and indices only move down, copying in order doesn't overwrite the ones we haven't read
+            for (int v = 0; v < numVertices && shift; v++)
+                SmallMemCpy(allVertices + (uint64_t)(vertexCursor + v) * vertexSize, allVertices + (uint64_t)(base + v) * vertexSize, vertexSize);
+            
+            const uint32_t* indices = (const uint32_t*)primitive.indices;
+            for (int i = 0; i < primitive.numIndices; i++)
+                allIndices[indexCursor + i] = indices[i] - shift;
 
-        if (curr < (const char*)AError_MAX) // is failed?
-        {
-            result->error = (AErrorType)(uint64_t)curr;
-            FreeAllText(source);
-            return 0;
+            primitive.vertices    = allVertices + (uint64_t)vertexCursor * vertexSize;
+            primitive.indices     = allIndices + indexCursor;
+            primitive.indexOffset = indexCursor;
+            primitive.numVertices = numVertices;
+
+            if (welded)
+            {
+                uint32_t slot = (uint32_t)HashPrimitive(primitive, vertexSize, vertexCursor) & mask;
+                APrimitive* same = nullptr;
+                for (; table[slot]; slot = (slot + 1) & mask)
+                {
+                    uint32_t sameBase = (uint32_t)(((char*)table[slot]->vertices - allVertices) / vertexSize);
+                    if (PrimitivesEqual(*table[slot], sameBase, primitive, vertexCursor, vertexSize)) { same = table[slot]; break; }
+                }
+
+                if (same != nullptr)
+                {
+                    primitive.vertices    = same->vertices;
+                    primitive.indices     = same->indices;
+                    primitive.indexOffset = same->indexOffset;
+                    continue;
+                }
+                table[slot] = &primitive;
+            }
+            vertexCursor += numVertices;
+            indexCursor  += primitive.numIndices;
         }
     }
 
-    for (int m = 0; m < meshes.Size(); ++m)
+    for (int i = numPrimitives - numShared; i < numPrimitives; i++)
     {
-        // get number of vertex, getting first attribute count because all of the others are same
-        AMesh mesh = meshes[m];
-        mesh.numPrimitives = SBCount(mesh.primitives);
-        for (int p = 0; p < mesh.numPrimitives; p++)
+        APrimitive& primitive = *owners[i];
+        int lo = 0, hi = numOwners - 1;
+        while (lo < hi) // last owner that starts before the shared primitive
         {
-            APrimitive& primitive = mesh.primitives[p];
-            // get position attrib's count because all attributes same
-            int numVertex = accessors[(int)(size_t)primitive.vertexAttribs[0]].count; 
-            primitive.numVertices = numVertex;
-        
-            // get number of index
-            GLTFAccessor accessor = accessors[primitive.indiceIndex];
-            primitive.numIndices = accessor.count;
+            int mid = (lo + hi + 1) >> 1;
+            if (oldOffsets[mid] <= primitive.indexOffset) lo = mid;
+            else hi = mid - 1;
+        }
+        const APrimitive& owner = *owners[lo];
+        primitive.vertices    = owner.vertices;
+        primitive.indices     = owner.indices;
+        primitive.indexOffset = owner.indexOffset;
+        primitive.numVertices = owner.numVertices;
+    }
 
-            accessor = accessors[primitive.indiceIndex];
-            GLTFBufferView view = bufferViews[accessor.bufferView];
-            int64_t offset = (int64_t)accessor.byteOffset + view.byteOffset;
-            // copy indices
-            primitive.indices = ((char*)buffers[view.buffer].uri) + offset;
-            primitive.indexType = accessor.componentType;
-            
-            // get joint data that we need for creating vertices
-            const int jointIndex = TrailingZeroCount32(AAttribType_JOINTS);
-            accessor = accessors[(int)(size_t)primitive.vertexAttribs[jointIndex]];
-            primitive.jointType   = (short)accessor.componentType;
-            primitive.jointCount  = (short)accessor.type;
-            primitive.jointStride = (short)bufferViews[accessor.bufferView].byteStride;
+    scene->totalVertices = (int)vertexCursor;
+    scene->totalIndices  = indexCursor;
+    AX_FREE(table);
+    AX_FREE(oldOffsets);
+    AX_FREE(owners);
+    AX_FREE(job.ranges);
+    return oldTotalVertices - (int)vertexCursor;
+}
 
-            // get weight data that we need for creating vertices
-            const int weightIndex = TrailingZeroCount32(AAttribType_WEIGHTS);
-            accessor = accessors[(int)(size_t)primitive.vertexAttribs[weightIndex]];
-            primitive.weightType   = (short)accessor.componentType;
-            primitive.weightStride = (short)bufferViews[accessor.bufferView].byteStride;
+enum { AMeshletMaxVertices = 64, AMeshletMaxTriangles = 124 };
 
-            // position, normal, texcoord are different buffers, 
-            // we are unifying all attributes to Vertex* buffer here
-            // even though attrib definition in gltf is not ordered, this code will order it, because we traversing set bits
-            // for example it converts from this: TexCoord, Normal, Position to Position, Normal, TexCoord
-            unsigned attributes = primitive.attributes;
-            for (int j = 0; attributes > 0 && j < AAttribType_Count; j += NextSetBit(&attributes))
-            {
-                accessor     = accessors[(int)(size_t)primitive.vertexAttribs[j]];
-                view         = bufferViews[accessor.bufferView];
-                offset       = int64_t(accessor.byteOffset) + view.byteOffset;
-                
-                primitive.vertexAttribs[j] = (char*)buffers[view.buffer].uri + offset;
-            }
+struct AMeshletOutput
+{
+    AMeshlet* meshlets;
+    uint32_t* vertices;
+    uint8_t*  triangles;
+    int numMeshlets, numVertices, numTriangles;
+};
+
+struct AMeshletJob
+{
+    APrimitiveRange* ranges;
+    AMeshletOutput*  outputs;
+    const char*      allVertices;
+    int vertexSize;
+    int positionOffset;
+};
+
+// bounding sphere is center of the AABB and farthest vertex, cone is same as meshoptimizer's computeClusterBounds
+__private void ComputeMeshletBounds(AMeshlet& meshlet, const uint32_t* vertices, const uint8_t* triangles, const AMeshletJob& job)
+{
+    float positions[AMeshletMaxVertices][3];
+    float mn[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, mx[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int v = 0; v < meshlet.numVertices; v++)
+    {
+        SmallMemCpy(positions[v], job.allVertices + (uint64_t)vertices[v] * job.vertexSize + job.positionOffset, sizeof(float) * 3);
+        for (int k = 0; k < 3; k++)
+            mn[k] = MIN(mn[k], positions[v][k]), mx[k] = MAX(mx[k], positions[v][k]);
+    }
+
+    float radiusSq = 0.0f;
+    for (int k = 0; k < 3; k++) meshlet.center[k] = (mn[k] + mx[k]) * 0.5f;
+    for (int v = 0; v < meshlet.numVertices; v++)
+    {
+        float dx = positions[v][0] - meshlet.center[0], dy = positions[v][1] - meshlet.center[1], dz = positions[v][2] - meshlet.center[2];
+        radiusSq = MAX(radiusSq, dx * dx + dy * dy + dz * dz);
+    }
+    meshlet.radius = Sqrt(radiusSq);
+
+    // average of triangle normals is the axis, zero area triangles are skipped
+    float normals[AMeshletMaxTriangles][3];
+    bool  hasNormal[AMeshletMaxTriangles];
+    float axis[3] = { 0.0f, 0.0f, 0.0f };
+    int numNormals = 0;
+    for (int t = 0; t < meshlet.numTriangles; t++)
+    {
+        const float* a = positions[triangles[t * 3 + 0]];
+        const float* b = positions[triangles[t * 3 + 1]];
+        const float* c = positions[triangles[t * 3 + 2]];
+        float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        float e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        float n[3]  = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+        float length = Sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        hasNormal[t] = length > 0.0f;
+        if (!hasNormal[t]) continue;
+        for (int k = 0; k < 3; k++)
+        {
+            normals[t][k] = n[k] / length;
+            axis[k] += normals[t][k];
         }
+        numNormals++;
     }
 
-    for (int s = 0; s < skins.Size(); s++)
+    float axisLength = Sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    float minDot = 1.0f;
+    for (int k = 0; k < 3; k++) 
+        axis[k] = axisLength > 0.0f ? axis[k] / axisLength : 0.0f;
+    for (int t = 0; t < meshlet.numTriangles; t++)
+        if (hasNormal[t]) minDot = MIN(minDot, normals[t][0] * axis[0] + normals[t][1] * axis[1] + normals[t][2] * axis[2]);
+    
+    SmallMemCpy(meshlet.coneAxis, axis, sizeof(axis));
+    SmallMemCpy(meshlet.coneApex, meshlet.center, sizeof(axis));
+    meshlet.coneCutoff = 1.0f;
+    // normals are spread more than 90 degrees (or there is no normal), cone can't cull
+    if (numNormals == 0 || axisLength == 0.0f || minDot <= 0.1f) return;
+
+    // apex is moved back on the axis until planes of all triangles are in front of it
+    float maxT = 0.0f;
+    for (int t = 0; t < meshlet.numTriangles; t++)
     {
-        ASkin& skin = skins[s];
-        size_t skinIndex = (size_t)skin.inverseBindMatrices;
-        GLTFAccessor   accessor  = accessors[(int)skinIndex];
-        GLTFBufferView view      = bufferViews[accessor.bufferView];
-        int64_t        offset    = int64_t(accessor.byteOffset) + view.byteOffset;
-        skin.inverseBindMatrices = (float*)((char*)buffers[view.buffer].uri + offset);
+        if (!hasNormal[t]) continue;
+        const float* a = positions[triangles[t * 3]];
+        const float* normal = normals[t];
+        float dc = (meshlet.center[0] - a[0]) * normal[0] + (meshlet.center[1] - a[1]) * normal[1] + (meshlet.center[2] - a[2]) * normal[2];
+        float dn = axis[0] * normal[0] + axis[1] * normal[1] + axis[2] * normal[2];
+        maxT = MAX(maxT, dc / dn);
     }
+    for (int k = 0; k < 3; k++)
+        meshlet.coneApex[k] = meshlet.center[k] - axis[k] * maxT;
+    meshlet.coneCutoff = Sqrt(1.0f - minDot * minDot); // cos(90 - angle)
+}
 
-    for (int a = 0; a < animations.Size(); a++)
+// triangles are added in index order until meshlet is full. uses a slot table to find meshlet's vertices
+__private void GenerateMeshlets(APrimitiveRange& range, AMeshletOutput& out, const AMeshletJob& job)
+{
+    const uint32_t* indices = range.indices;
+    int numIndices  = range.primitive->numIndices;
+    int numVertices = range.primitive->numVertices;
+    uint32_t base   = range.base;
+    MemsetZero(&out, sizeof(AMeshletOutput));
+
+    for (int i = 0; i < numIndices; i++)
+        if (indices[i] - base >= (uint32_t)numVertices) return;
+
+    // a meshlet is closed when vertices doesn't fit, each triangle adds at most 3 vertices so it has at least 21 triangles
+    int numTriangles = numIndices / 3;
+    int maxMeshlets  = numTriangles / ((AMeshletMaxVertices - 2) / 3) + 1;
+    out.meshlets  = (AMeshlet*)AX_MALLOC(sizeof(AMeshlet) * maxMeshlets);
+    out.vertices  = (uint32_t*)AX_MALLOC(sizeof(uint32_t) * numIndices + numVertices);
+    out.triangles = (uint8_t*)AX_MALLOC(numIndices);
+    uint8_t* slots = (uint8_t*)(out.vertices + numIndices); // vertex's index in the current meshlet
+    SmallMemSet(slots, 0xFF, numVertices);
+
+    AMeshlet meshlet{};
+    for (int t = 0; t < numTriangles; t++)
     {
-        AAnimation& animation = animations[a];
-        animation.duration = 0.0f;
+        uint32_t tri[3] = { indices[t * 3] - base, indices[t * 3 + 1] - base, indices[t * 3 + 2] - base };
+        int newVertices = (slots[tri[0]] == 0xFF) + (slots[tri[1]] == 0xFF) + (slots[tri[2]] == 0xFF);
 
-        for (int s = 0; s < animation.numSamplers; s++)
+        if (meshlet.numVertices + newVertices > AMeshletMaxVertices || meshlet.numTriangles == AMeshletMaxTriangles)
         {
-            AAnimSampler& sampler = animation.samplers[s];
-            size_t inputIndex = (size_t)sampler.input;
-            GLTFAccessor   accessor  = accessors[(int)inputIndex];
-            GLTFBufferView view      = bufferViews[accessor.bufferView];
-            int64_t        offset    = int64_t(accessor.byteOffset) + view.byteOffset;
-            
-            sampler.input = (float*)((char*)buffers[view.buffer].uri + offset);
-            sampler.count = accessor.count;
-            
-            size_t outputIndex = (size_t)sampler.output;
-            accessor = accessors[(int)outputIndex];
-            view     = bufferViews[accessor.bufferView];
-            offset   = int64_t(accessor.byteOffset) + view.byteOffset;
-            
-            sampler.output = (float*)((char*)buffers[view.buffer].uri + offset);
-            sampler.count = MIN(sampler.count, accessor.count);
-            sampler.numComponent = accessor.type;
-            
-            animation.duration = MAX(animation.duration, sampler.input[sampler.count - 1]);
+            ComputeMeshletBounds(meshlet, out.vertices + meshlet.vertexOffset, out.triangles + meshlet.triangleOffset * 3, job);
+            out.meshlets[out.numMeshlets++] = meshlet;
+            for (int v = 0; v < meshlet.numVertices; v++)
+                slots[out.vertices[meshlet.vertexOffset + v] - base] = 0xFF;
+
+            MemsetZero(&meshlet, sizeof(AMeshlet));
+            meshlet.vertexOffset   = out.numVertices;
+            meshlet.triangleOffset = out.numTriangles;
         }
-    }
 
-    // calculate num vertices and indices
-    {
-        int totalVertexCount = 0;
-        int totalIndexCount = 0;
-        // Calculate total vertices, and indices
-        for (int m = 0; m < meshes.Size(); ++m)
+        for (int k = 0; k < 3; k++)
         {
-            AMesh mesh = meshes[m];
-            for (int p = 0; p < mesh.numPrimitives; p++)
+            if (slots[tri[k]] == 0xFF)
             {
-                APrimitive& primitive = mesh.primitives[p];
-                totalIndexCount  += primitive.numIndices;
-                totalVertexCount += primitive.numVertices;
+                slots[tri[k]] = meshlet.numVertices++;
+                out.vertices[out.numVertices++] = base + tri[k];
             }
+            out.triangles[out.numTriangles * 3 + k] = slots[tri[k]];
         }
-
-        result->totalIndices  = totalIndexCount;
-        result->totalVertices = totalVertexCount;
+        out.numTriangles++;
+        meshlet.numTriangles++;
     }
 
-    result->stringAllocator = stringAllocator.TakeOwnership();
-    result->intAllocator    = intAllocator.TakeOwnership();
-
-    result->numMeshes     = meshes.Size();     result->meshes     = meshes.TakeOwnership();
-    result->numNodes      = nodes.Size();      result->nodes      = nodes.TakeOwnership();
-    result->numMaterials  = materials.Size();  result->materials  = materials.TakeOwnership();
-    result->numTextures   = textures.Size();   result->textures   = textures.TakeOwnership(); 
-    result->numImages     = images.Size();     result->images     = images.TakeOwnership();
-    result->numSamplers   = samplers.Size();   result->samplers   = samplers.TakeOwnership();
-    result->numCameras    = cameras.Size();    result->cameras    = cameras.TakeOwnership();
-    result->numScenes     = scenes.Size();     result->scenes     = scenes.TakeOwnership();
-    result->numBuffers    = buffers.Size();    result->buffers    = buffers.TakeOwnership();
-    result->numAnimations = animations.Size(); result->animations = animations.TakeOwnership();
-    result->numSkins      = skins.Size();      result->skins      = skins.TakeOwnership();
-    result->scale = scale;
-    result->error = AError_NONE;
-    FreeAllText(source);
-    return 1;
-}
-
-__public void FreeGLTFBuffers(SceneBundle* gltf)
-{
-    for (int i = 0; i < gltf->numBuffers; i++)
+    if (meshlet.numTriangles > 0)
     {
-        FreeAllText((char*)gltf->buffers[i].uri);
-        gltf->buffers[i].uri = nullptr;
+        ComputeMeshletBounds(meshlet, out.vertices + meshlet.vertexOffset, out.triangles + meshlet.triangleOffset * 3, job);
+        out.meshlets[out.numMeshlets++] = meshlet;
     }
-    FreeAligned(gltf->buffers);
-    gltf->numBuffers = 0;
-    gltf->buffers = nullptr;
 }
 
-__public void FreeGLTF(SceneBundle* gltf)
+static void GenerateMeshletsTask(int index, void* arg)
 {
-    struct CharFragment { 
-        CharFragment* next; char* ptr; int64_t   size;
-    };
-
-    struct IntFragment { 
-        IntFragment* next; int* ptr; int64_t   size;
-    };
+    AMeshletJob* job = (AMeshletJob*)arg;
+    GenerateMeshlets(job->ranges[index], job->outputs[index], *job);
+}
 
-    for (int i = 0; i < gltf->numBuffers; i++)
+__public void AGenerateMeshlets(SceneBundle* scene, int positionOffset, int numThreads)
+{
+    FreeMeshlets(scene);
+    if (scene->allVertices == nullptr || scene->vertexSize == 0) return;
+
+    AMeshletJob job;
+    int numRanges;
+    job.ranges         = CollectPrimitiveRanges(scene, &numRanges);
+    job.outputs        = (AMeshletOutput*)AX_MALLOC(sizeof(AMeshletOutput) * MAX(numRanges, 1));
+    job.allVertices    = (const char*)scene->allVertices;
+    job.vertexSize     = scene->vertexSize;
+    job.positionOffset = positionOffset;
+    AParallelFor(numRanges, GenerateMeshletsTask, &job, numThreads);
+
+    for (int i = 0; i < numRanges; i++)
     {
-        FreeAllText((char*)gltf->buffers[i].uri);
+        scene->totalMeshlets         += job.outputs[i].numMeshlets;
+        scene->totalMeshletVertices  += job.outputs[i].numVertices;
+        scene->totalMeshletTriangles += job.outputs[i].numTriangles;
     }
+    scene->meshlets         = (AMeshlet*)AllocAligned(sizeof(AMeshlet) * MAX(scene->totalMeshlets, 1), 16);
+    scene->meshletVertices  = (unsigned*)AllocAligned(sizeof(uint32_t) * MAX(scene->totalMeshletVertices, 1), 16);
+    scene->meshletTriangles = (unsigned char*)AllocAligned(3ull * MAX(scene->totalMeshletTriangles, 1), 16);
 
-    if (gltf->stringAllocator)
+    int meshletCursor = 0, vertexCursor = 0, triangleCursor = 0;
+    for (int i = 0; i < numRanges; i++)
     {
-        // free allocators
-        CharFragment* base = (CharFragment*)gltf->stringAllocator;
-
-        while (base)
+        AMeshletOutput& out = job.outputs[i];
+        for (int m = 0; m < out.numMeshlets; m++)
         {
-            FreeAligned(base->ptr);
-            CharFragment* oldBase = base;
-            base = base->next;
-            FreeAligned(oldBase);
+            AMeshlet meshlet = out.meshlets[m];
+            meshlet.vertexOffset   += vertexCursor;
+            meshlet.triangleOffset += triangleCursor;
+            scene->meshlets[meshletCursor + m] = meshlet;
         }
-    }
-    
-    if (gltf->intAllocator)
-    {
-        IntFragment* ibase = (IntFragment*)gltf->intAllocator;
-
-        while (ibase )
+        SmallMemCpy(scene->meshletVertices + vertexCursor, out.vertices, sizeof(uint32_t) * out.numVertices);
+        SmallMemCpy(scene->meshletTriangles + triangleCursor * 3, out.triangles, 3ull * out.numTriangles);
+        
+        job.ranges[i].primitive->meshletOffset = meshletCursor;
+        job.ranges[i].primitive->numMeshlets   = out.numMeshlets;
+        meshletCursor  += out.numMeshlets;
+        vertexCursor   += out.numVertices;
+        triangleCursor += out.numTriangles;
+        if (out.meshlets) 
         {
-            FreeAligned(ibase->ptr);
-            IntFragment* oldBase = ibase ;
-            ibase  = ibase->next;
-            FreeAligned(oldBase);
+            AX_FREE(out.meshlets);
+            AX_FREE(out.vertices);
+            AX_FREE(out.triangles);
         }
     }
 
-    // also controls if arrays null or not
-    for (int i = 0; i < gltf->numMeshes; i++)
-        SBFree(gltf->meshes[i].primitives);
-
-    if (gltf->meshes)      FreeAligned(gltf->meshes);
-    if (gltf->nodes)       FreeAligned(gltf->nodes);
-    if (gltf->materials)   FreeAligned(gltf->materials);
-    if (gltf->textures)    FreeAligned(gltf->textures);
-    if (gltf->images)      FreeAligned(gltf->images);
-    if (gltf->samplers)    FreeAligned(gltf->samplers);
-    if (gltf->cameras)     FreeAligned(gltf->cameras);
-    if (gltf->scenes)      FreeAligned(gltf->scenes);
-    if (gltf->skins)       FreeAligned(gltf->skins);
-    if (gltf->animations)
+    // primitives that are shared by AWeldVertices use meshlets of the owner, ranges are sorted by index offset
+    int r = 0, indexCursor = 0;
+    for (int m = 0; m < scene->numMeshes; m++)
     {
-        for (int i = 0; i < gltf->numAnimations; i++)
+        for (int p = 0; p < scene->meshes[m].numPrimitives; p++)
         {
-            FreeAligned(gltf->animations[i].samplers);
-            FreeAligned(gltf->animations[i].channels);
+            APrimitive& primitive = scene->meshes[m].primitives[p];
+            if (r < numRanges && job.ranges[r].primitive == &primitive) 
+            {
+                r++;
+                indexCursor = primitive.indexOffset + primitive.numIndices;
+                continue;
+            }
+            primitive.meshletOffset = primitive.numMeshlets = 0;
+            if (primitive.indexOffset >= indexCursor) 
+            {
+                indexCursor = primitive.indexOffset + primitive.numIndices;
+                continue;
+            }
+            int lo = 0, hi = r - 1;
+            while (lo < hi)
+            {
+                int mid = (lo + hi + 1) >> 1;
+                if (job.ranges[mid].primitive->indexOffset <= primitive.indexOffset) lo = mid;
+                else hi = mid - 1;
+            }
+            const APrimitive* owner = r > 0 ? job.ranges[lo].primitive : nullptr;
+            if (owner && owner->indexOffset == primitive.indexOffset)
+            {
+                primitive.meshletOffset = owner->meshletOffset;
+                primitive.numMeshlets   = owner->numMeshlets;
+            }
         }
-        FreeAligned(gltf->animations);
     }
-    if (gltf->allVertices) FreeAligned(gltf->allVertices);
-    if (gltf->allIndices)  FreeAligned(gltf->allIndices);
-    
-    MemsetZero(gltf, sizeof(SceneBundle));
+    AX_FREE(job.outputs);
+    AX_FREE(job.ranges);
 }
 
 const char* ParsedSceneGetError(AErrorType error)
@@ -3667,6 +8031,8 @@ const char* ParsedSceneGetError(AErrorType error)
                                           "UNKNOWN_DESCRIPTOR",
                                           "HASH_COLISSION",
                                           "NON_UTF8",
+                                          "EXT_NOT_SUPPORTED",
+                                          "INVALID_GLB",
                                           "MAX" };
     return SceneParseErrorToStr[error];
 }
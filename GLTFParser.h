@@ -6,7 +6,7 @@
 *    Author:                                                     *
 *        Anilcan Gulkaya 2023 anilcangulkaya7@gmail.com          *
 *    Restrictions:                                               *
-*        No extension and .glb support.                          *
+*        No extension support.                                   *
 *    License:                                                    *
 *        No License whatsoever do Whatever you want.             *
 *                                                                *
@@ -50,6 +50,7 @@ enum AErrorType_
     AError_HASH_COLISSION,
     AError_NON_UTF8,
     AError_EXT_NOT_SUPPORTED, // scenes other than GLTF, OBJ or Fbx
+    AError_INVALID_GLB,       // wrong magic, version or chunk layout
     AError_MAX
 };
 typedef int AErrorType;
@@ -105,6 +106,9 @@ typedef struct AMaterial_
 typedef struct AImage_
 {
     char* path;
+    void* data; // only set if scene loaded with ParseGLTFFromMemory and resolver resolved the uri
+    unsigned long long dataSize;
+    int ownsData; // data freed with FreeGLTF
 } AImage;
 
 typedef struct ANode_
@@ -122,17 +126,40 @@ typedef struct ANode_
     int*  children;
 } ANode;
 
+// accessor that has sparse block, elements at indices are replaced with values, rest of them are same as base.
+// if accessor doesn't have bufferView base is null and rest of the elements are zero
+typedef struct ASparseAccessor_
+{
+    void* base;    // dense data that values are written over, can be null
+    void* indices; // indices of the replaced elements, indexType
+    void* values;  // replaced elements, tightly packed
+    void* dense;   // densified copy, created with the first ASparseGetDense call, freed with FreeGLTF
+    int count;         // number of replaced elements
+    int numElements;   // count of the accessor
+    int indexType;     // GraphicType_UnsignedByte, GraphicType_UnsignedShort or GraphicType_UnsignedInt
+    int componentType; // GraphicType of base and values
+    int numComponents; // 1 scalar, 2 vec2, 3 vec3, 4 vec4, 16 mat4
+    int byteStride;    // stride of base, 0 is tightly packed
+} ASparseAccessor;
+
 typedef struct APrimitive_
 {
     // pointers to binary file to lookup position, texture, normal..
     void* indices; 
     void* vertices;
+    // indices and vertex count in the buffers, ACreateVerticesIndices reads them so it can be called again with another layout
+    void* sourceIndices;
+    int sourceIndexType;
+    int numSourceVertices;
     
     unsigned attributes; // AAttribType Position, Normal, TexCoord, Tangent, masks
+    unsigned sparseAttributes; // AAttribType masks, vertexAttribs of these attributes are ASparseAccessor*
     int indexType; // GraphicType_UnsignedInt, GraphicType_UnsignedShort.. 
     int numIndices;
     int numVertices;
     int indexOffset;
+    int meshletOffset; // first meshlet of the primitive in SceneBundle::meshlets, see AGenerateMeshlets
+    int numMeshlets;
     short jointType;   // GraphicType_UnsignedInt, GraphicType_UnsignedShort.. 
     short jointCount;  // per vertex bone count (joint), 1-4
     short jointStride; // lets say index data is rgba16u  [r, g, b, a, .......] stride might be bigger than joint
@@ -141,7 +168,7 @@ typedef struct APrimitive_
     short weightStride; // lets say index data is rgba16u  [r, g, b, a, .......] stride might be bigger than joint
 
     // internal use only. after parsing this is useless
-    short indiceIndex; // indice index to accessor
+    int   indiceIndex; // indice index to accessor
     short material;    // material index
     short mode;        // 4 is triangle
 
@@ -151,11 +178,59 @@ typedef struct APrimitive_
     // texCoords = (Vector2f*)vertexAttribs[1]; // note that tangent is vec4
     // ...
     void* vertexAttribs[AAttribType_Count]; 
+    unsigned char vertexStrides[AAttribType_Count]; // byteStride of each attribute, 0 is tightly packed
     // AABB min and max
     float min[4];
     float max[4];
 } APrimitive;
 
+// vertex that ACreateVerticesIndices writes, 32 bytes
+typedef struct ASkinnedVertex_
+{
+    float    position[3];
+    unsigned normal;   // INT_2_10_10_10_REV, xyz are 10 bit snorm
+    unsigned tangent;  // INT_2_10_10_10_REV, w is handedness (1 or -1)
+    unsigned texCoord; // two half floats
+    unsigned joints;   // 4 x 8 bit joint indices
+    unsigned weights;  // 4 x 8 bit unorm weights
+} ASkinnedVertex;
+
+// how an attribute is written into the vertex
+enum AVertexEncoding_
+{
+    AVertexEncoding_Float,    // copied as it is: float3 position/normal, float4 tangent, float2 texcoord
+    AVertexEncoding_Snorm10,  // normal or tangent, INT_2_10_10_10_REV 4 bytes
+    AVertexEncoding_Half2,    // texcoord, two half floats 4 bytes
+    AVertexEncoding_Uint8x4,  // joints, 4 x 8 bit indices
+    AVertexEncoding_Unorm8x4, // weights, 4 x 8 bit unorm
+    AVertexEncoding_Count
+};
+typedef int AVertexEncoding;
+
+// one attribute of the vertex layout, offset is in bytes from start of the vertex
+typedef struct AVertexElement_
+{
+    AAttribType attrib;
+    AVertexEncoding encoding;
+    int offset;
+} AVertexElement;
+
+// cluster of triangles for culling, created by AGenerateMeshlets. 
+// meshlet's vertices are meshletVertices[vertexOffset...] (indices into allVertices) and triangles are 
+// meshletTriangles[triangleOffset * 3...], 3 bytes per triangle that index meshlet's vertices
+typedef struct AMeshlet_
+{
+    float center[3]; // bounding sphere
+    float radius;
+    float coneApex[3]; // normal cone, meshlet is backfacing if dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff
+    float coneCutoff;  // 1 if meshlet can't be culled with the cone
+    float coneAxis[3];
+    unsigned vertexOffset;
+    unsigned triangleOffset;
+    unsigned char numVertices;  // at most 64
+    unsigned char numTriangles; // at most 124
+} AMeshlet;
+
 typedef struct AMesh_
 {
     char* name;  
@@ -199,10 +274,21 @@ typedef struct AScene_
 } AScene;
 
 
+enum ABufferFlag_
+{
+    ABufferFlag_None     = 0,      // uri is allocated by the parser, freed with FreeGLTFBuffers
+    ABufferFlag_GLB      = 1 << 0, // uri points to BIN chunk of the .glb file, memory owned by SceneBundle::glbSource or by the caller of ParseGLTFFromMemory
+    ABufferFlag_Mapped   = 1 << 1, // uri is read only memory mapped file, FreeGLTFBuffers unmaps it
+    ABufferFlag_External = 1 << 2  // uri is given by AUriResolver and not owned by the parser
+};
+typedef int ABufferFlag;
+
 typedef struct GLTFBuffer_
 {
     void* uri;
     int byteLength;
+    ABufferFlag flags;
+    unsigned long long mappedSize; // size of the file mapping, only used with ABufferFlag_Mapped
 } GLTFBuffer;
 
 typedef struct ASkin_
@@ -260,18 +346,19 @@ typedef struct AAnimation_
 // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html
 typedef struct SceneBundle_
 {
-    short numMeshes;
-    short numNodes;
-    short numMaterials;
-    short numTextures;
-    short numImages;
-    short numSamplers;
-    short numCameras;
-    short numScenes;
-    short defaultSceneIndex;
-    short numBuffers;
-    short numAnimations;
-    short numSkins;
+    int numMeshes;
+    int numNodes;
+    int numMaterials;
+    int numTextures;
+    int numImages;
+    int numSamplers;
+    int numCameras;
+    int numScenes;
+    int defaultSceneIndex;
+    int numBuffers;
+    int numAnimations;
+    int numSkins;
+    int numSparseAccessors;
 
     AErrorType error;
 
@@ -279,12 +366,23 @@ typedef struct SceneBundle_
     void* intAllocator;
     void* allVertices;
     void* allIndices;
+    AMeshlet* meshlets; // created with AGenerateMeshlets, primitives has meshletOffset and numMeshlets
+    unsigned* meshletVertices;
+    unsigned char* meshletTriangles;
 
     int totalVertices;
     int totalIndices;
+    int vertexSize; // size of one vertex in allVertices, set by ACreateVerticesIndices
+    int totalMeshlets;
+    int totalMeshletVertices;
+    int totalMeshletTriangles;
     float scale;
 
     GLTFBuffer* buffers;
+    void* glbSource; // whole .glb file, BIN chunk buffer points into this. null if scene is .gltf
+    void* cacheMapping; // set if scene is loaded with LoadGLTFCache, all of the scene is in this mapping
+    unsigned long long cacheSize;
+    void* arena; // set if scene is loaded with ALoadFlags_Arena, metadata is in this block and freed with one call
 
     AMesh      *meshes;
     ANode      *nodes;
@@ -296,14 +394,176 @@ typedef struct SceneBundle_
     AScene     *scenes;
     AAnimation *animations;
     ASkin      *skins;
+    ASparseAccessor *sparseAccessors; // skins and animations that use sparse accessors point to dense copies of them
 } SceneBundle;
 
+enum ALoadFlags_
+{
+    ALoadFlags_None         = 0,
+    ALoadFlags_MapBuffers   = 1 << 0, // memory map .bin files instead of reading them, pages are loaded when accessors are used
+    ALoadFlags_AsyncBuffers = 1 << 1, // read .bin files on io thread while json is being parsed
+    ALoadFlags_SelectScene  = 1 << 2, // only load ALoadOptions::sceneIndex
+    ALoadFlags_ParallelSections = 1 << 3, // parse top level arrays (nodes, meshes, animations...) on multiple threads, ignored with selective loading
+    ALoadFlags_ParallelArrays   = 1 << 4, // split huge nodes and accessors arrays between threads, output is same as serial parsing, serial with ALoadFlags_ParallelSections
+    ALoadFlags_CountElements    = 1 << 5, // count elements of each array before parsing, so arrays are allocated once with exact size
+    ALoadFlags_Arena            = 1 << 6  // all of the metadata (arrays, names, primitives...) is moved into one block after parsing
+};
+typedef int ALoadFlags;
+
+// selective loading: if ALoadFlags_SelectScene is set or there are node/mesh names, only selected part of the scene is loaded.
+// selected nodes are: nodes of the scene, named nodes, their children and nodes that use named meshes.
+// meshes, materials, skins and buffers that are not used by selected nodes are skipped, 
+// all nodes are parsed and skipped meshes and materials stay empty so indices doesn't change. 
+// animations that doesn't target selected nodes are removed.
+typedef struct ALoadOptions_
+{
+    ALoadFlags flags;
+    int sceneIndex; // used with ALoadFlags_SelectScene, -1 is default scene
+    int numNodeNames;
+    int numMeshNames;
+    const char* const* nodeNames; // selects these nodes and their children
+    const char* const* meshNames; // selects these meshes
+    int numThreads; // used with ALoadFlags_ParallelSections and ALoadFlags_ParallelArrays, 0 is number of cpu cores
+} ALoadOptions;
+
+typedef struct AResolvedData_
+{
+    void* data;
+    unsigned long long size;
+    int owned; // if true parser takes the ownership and frees it with AX_FREE(delete[] by default)
+} AResolvedData;
+
+// resolves buffer and image uris for ParseGLTFFromMemory, uri is the string in the json(not decoded)
+// return 0 if uri can't be resolved. resolver is not called for data uris, buffers are decoded by the parser, images keep the uri in AImage::path
+typedef int(*AUriResolver)(const char* uri, AResolvedData* out, void* userData);
+
 // if there is an error error will be minus GLTFErrorType
-// out scene should not be null
+// out scene should not be null, path can be .gltf or .glb
 extern int ParseGLTF(const char* path, SceneBundle* scene, float scale);
+// same as ParseGLTF, options can be null
+extern int ParseGLTFEx(const char* path, SceneBundle* scene, float scale, const ALoadOptions* options);
+// parses .gltf or .glb that is already in memory, data is not modified and can be freed after parsing,
+// unless scene is .glb, BIN chunk buffer points into data, so it should live until FreeGLTF.
+// resolver can be null, in that case only embedded buffers and glb BIN chunk can be used
+extern int ParseGLTFFromMemory(const char* data, unsigned long long size, SceneBundle* scene, float scale, 
+                               AUriResolver resolver, void* userData, const ALoadOptions* options);
+// writes whole scene into one file that can be loaded with LoadGLTFCache, pointers are stored as offsets.
+// buffers are copied too, so .bin files are not needed. allVertices and allIndices are written if they are created,
+// sourcePath can be null, otherwise it's modified time and size is stored for validating the cache.
+// cache only depends on the scene, if you use different scale or load options use different cache files.
+extern int SaveGLTFCache(const SceneBundle* scene, const char* cachePath, const char* sourcePath);
+// maps the cache file and fixes the pointers, returns 0 if cache is not exist, 
+// invalid or out of date (source file's modified time or size is changed). sourcePath can be null
+// free with FreeGLTF, FreeGLTFBuffers doesn't free anything for cached scenes
+extern int LoadGLTFCache(const char* cachePath, const char* sourcePath, SceneBundle* scene);
+// parses files on multiple threads, scenes[i] is the result of paths[i], errors are in scenes[i].error.
+// numThreads 0 means number of cpu cores, options can be null. returns number of successfully parsed files
+extern int ParseGLTFBatch(const char* const* paths, SceneBundle* scenes, int numFiles, float scale, 
+                          const ALoadOptions* options, int numThreads);
+// json number to float that parser uses, correctly rounded (same result as strtof in "C" locale).
+// leading whitespace is skipped, end is set to after the number or to text if there is no number, end can be null
+extern float AParseFloat(const char* text, const char** end);
+// packs vertices of all primitives into allVertices as ASkinnedVertex and indices into allIndices as uint32.
+// indices are rebased, so they index allVertices. primitive's vertices, indices and indexOffset are set, indexType becomes uint32.
+// missing attributes are zero, normals too, so meshes without normals need generated ones. sparse attributes are densified.
+// buffers are not needed after this, see FreeGLTFBuffers. allVertices size is totalVertices * sizeof(ASkinnedVertex), allIndices size is totalIndices * 4, freed with FreeGLTF
+// calling it again while buffers are loaded repacks from the buffers, previous vertices, indices and meshlets are freed, welding and optimizations are discarded
+extern void ACreateVerticesIndices(SceneBundle* scene);
+// same as ACreateVerticesIndices but vertices are written with the given layout, allVertices size is totalVertices * vertexSize.
+// missing attributes of the primitive are zero, bytes of the vertex that are not covered by elements are zeroed too. see AVertexLayout below
+extern void ACreateVerticesIndicesLayout(SceneBundle* scene, const AVertexElement* elements, int numElements, int vertexSize);
+// copies count indices from src to dst and adds base to them (to make them index a combined vertex buffer).
+// types are same as APrimitive::indexType: 1 uint8, 3 uint16, 5 uint32. src can be any of them, dstType is 3 or 5.
+// uint16 output is only valid if base + biggest index fits into 16 bits, for example base + numVertices <= 65536
+extern void ARebaseIndices(void* dst, int dstType, const void* src, int srcType, int count, unsigned base);
+// reorders triangles of each primitive for post transform vertex cache (Tom Forsyth's algorithm), call after ACreateVerticesIndices.
+// primitives are optimized in parallel, numThreads 0 means number of cpu cores. acmrBefore and acmrAfter can be null,
+// otherwise average cache miss ratio (misses per triangle, 16 entry fifo cache) of all triangles before and after is written
+extern void AOptimizeVertexCache(SceneBundle* scene, int numThreads, float* acmrBefore, float* acmrAfter);
+// moves vertices of each primitive in allVertices into the order that indices first use them and rewrites the indices,
+// call after ACreateVerticesIndices (and after AOptimizeVertexCache). whole vertex is moved so all attributes stay together.
+// unused vertices are moved to end of the primitive. vertexAttribs of the primitive are not reordered
+extern void AOptimizeVertexFetch(SceneBundle* scene, int numThreads);
+// removes duplicate vertices of each primitive (vertices that has same bytes in allVertices, attributes are already
+// quantized by packing so nearly same normals and uvs are welded too) and rewrites indices, primitives are welded in parallel.
+// primitives that have exactly same vertices and indices share the first one's vertices, indices and indexOffset.
+// allVertices and allIndices are compacted, totalVertices and totalIndices are updated. returns number of removed vertices.
+// whole vertex is compared including padding, ACreateVerticesIndices zeroes the padding. if you write allVertices yourself zero it too
+extern int AWeldVertices(SceneBundle* scene, int numThreads);
+// splits triangles of each primitive into meshlets (at most 64 vertices and 124 triangles) with bounding sphere and normal cone.
+// call after ACreateVerticesIndices, better after AOptimizeVertexCache because triangles are added in index order.
+// positionOffset is offset of float3 position in the vertex (0 for ASkinnedVertex). primitives are processed in parallel.
+// meshlets, meshletVertices and meshletTriangles of the scene are freed with FreeGLTF
+extern void AGenerateMeshlets(SceneBundle* scene, int positionOffset, int numThreads);
+// size of one element of the sparse accessor in bytes, for example 12 for float vec3
+extern int ASparseElementSize(const ASparseAccessor* sparse);
+// writes replaced elements of sparse accessor into dst, rest of the dst is not touched so it should already have the base.
+// stride is distance between elements of dst in bytes, 0 is tightly packed. can write into interleaved vertex buffers
+extern void ASparseApply(const ASparseAccessor* sparse, void* dst, int stride);
+// writes all of the elements (base with replaced elements) into dst, dst size is numElements * ASparseElementSize
+extern void ASparseCopy(const ASparseAccessor* sparse, void* dst);
+// densified copy of the accessor, allocated on first call and freed with FreeGLTF. not thread safe for the same accessor
+extern const void* ASparseGetDense(ASparseAccessor* sparse);
 // Free
 extern void FreeParsedGLTF(SceneBundle* gltf);
 void FreeGLTFBuffers(SceneBundle* gltf);
 extern const char* ParsedSceneGetError(AErrorType error);
 
+#ifdef __cplusplus
+// compile time vertex layout, for example position only depth pass vertex:
+//     struct DepthVertex { float position[3]; };
+//     typedef AVertexLayout<DepthVertex, AVertexAttrib<AAttribType_POSITION, AVertexEncoding_Float, 0>> DepthLayout;
+//     ACreateVerticesIndices<DepthLayout>(scene);
+// encodings and offsets are checked at compile time. each attribute is packed for whole primitive with the kernel
+// of it's encoding, so presence of the attribute is checked once per primitive not per vertex
+template<int attrib_, int encoding_, int offset_>
+struct AVertexAttrib
+{
+    enum
+    {
+        attrib = attrib_, encoding = encoding_, offset = offset_,
+        numComponents = attrib_ == AAttribType_TANGENT ? 4 : attrib_ == AAttribType_POSITION || attrib_ == AAttribType_NORMAL ? 3 : 2,
+        size = encoding_ == AVertexEncoding_Float ? numComponents * 4 : 4,
+        end  = offset_ + size
+    };
+    static_assert(encoding_ != AVertexEncoding_Snorm10  || attrib_ == AAttribType_NORMAL || attrib_ == AAttribType_TANGENT, "snorm10 is for normals and tangents");
+    static_assert(encoding_ != AVertexEncoding_Half2    || attrib_ == AAttribType_TEXCOORD_0 || attrib_ == AAttribType_TEXCOORD_1, "half2 is for texcoords");
+    static_assert(encoding_ != AVertexEncoding_Uint8x4  || attrib_ == AAttribType_JOINTS, "uint8x4 is for joints");
+    static_assert(encoding_ != AVertexEncoding_Unorm8x4 || attrib_ == AAttribType_WEIGHTS, "unorm8x4 is for weights");
+    static_assert(encoding_ != AVertexEncoding_Float    || (attrib_ != AAttribType_JOINTS && attrib_ != AAttribType_WEIGHTS), "joints and weights can't be float");
+    static_assert(encoding_ >= 0 && encoding_ < AVertexEncoding_Count, "unknown encoding");
+    static_assert(offset_ % 4 == 0, "attributes must be 4 byte aligned");
+};
+
+// biggest end offset of the attributes
+constexpr int AVertexLayoutEnd() { return 0; }
+template<typename... Rest>
+constexpr int AVertexLayoutEnd(int end, Rest... rest) { return end > AVertexLayoutEnd(rest...) ? end : AVertexLayoutEnd(rest...); }
+
+template<typename Vertex, typename... Attribs>
+struct AVertexLayout
+{
+    static_assert(sizeof...(Attribs) > 0, "layout must have at least one attribute");
+    static_assert(AVertexLayoutEnd(Attribs::end...) <= (int)sizeof(Vertex), "attribute is out of the vertex");
+    typedef Vertex VertexType;
+
+    static void Pack(SceneBundle* scene)
+    {
+        static const AVertexElement elements[] = { { Attribs::attrib, Attribs::encoding, Attribs::offset }... };
+        ACreateVerticesIndicesLayout(scene, elements, (int)sizeof...(Attribs), (int)sizeof(Vertex));
+    }
+};
+
+// layout of ASkinnedVertex, ACreateVerticesIndices(scene) uses this
+typedef AVertexLayout<ASkinnedVertex, AVertexAttrib<AAttribType_POSITION,   AVertexEncoding_Float,    0>,
+                                      AVertexAttrib<AAttribType_NORMAL,     AVertexEncoding_Snorm10,  12>,
+                                      AVertexAttrib<AAttribType_TANGENT,    AVertexEncoding_Snorm10,  16>,
+                                      AVertexAttrib<AAttribType_TEXCOORD_0, AVertexEncoding_Half2,    20>,
+                                      AVertexAttrib<AAttribType_JOINTS,     AVertexEncoding_Uint8x4,  24>,
+                                      AVertexAttrib<AAttribType_WEIGHTS,    AVertexEncoding_Unorm8x4, 28>> ASkinnedVertexLayout;
+
+template<typename Layout>
+inline void ACreateVerticesIndices(SceneBundle* scene) { Layout::Pack(scene); }
+#endif
+
 #endif // AX_GLTF_PARSER